@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_ENABLE_BATCH_PARSE
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Measures the throughput of cargs_parse_batch, with a growing number of worker threads. Every job
+ * is a small command line, similar to a recorded invocation of a typical tool. Throughput should
+ * grow with the thread count, till the number of CPU cores.
+ **************************************************************************************************/
+
+#define JOB_COUNT    1000000
+#define REPEAT_COUNT 3
+
+static char* job_argv[] = { "bench", "-n", "123", "-v", "-r", "0.5", "-I", "a", "b", "c", NULL };
+static Cargs_BatchJob jobs[JOB_COUNT];
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main (void)
+{
+    static const unsigned thread_counts[] = { 1, 2, 4, 8 };
+
+    Cargs_Parser schema = { 0 };
+    cargs_parser_add_arg (&schema, "n", "Count", Integer, NULL);
+    cargs_parser_add_arg (&schema, "v", "Verbose", Flag, "false");
+    cargs_parser_add_arg (&schema, "r", "Ratio", Double, "1.0");
+    cargs_parser_add_arg (&schema, "o", "Output", String, "out");
+    cargs_parser_add_arg (&schema, "I", "Inputs", CARGS_LISTOF (StringView), NULL);
+    cargs_parser_freeze (&schema);
+
+    for (size_t i = 0; i < JOB_COUNT; i++) {
+        jobs[i] = (Cargs_BatchJob){ .argc = CARGS__ARRAY_LEN (job_argv) - 1, .argv = job_argv };
+    }
+
+    printf ("%-10s %s\n", "threads", "jobs/s");
+    for (unsigned i = 0; i < CARGS__ARRAY_LEN (thread_counts); i++) {
+        double best = 0;
+        for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+            double start = now_ns();
+            if (!cargs_parse_batch (&schema, jobs, JOB_COUNT, thread_counts[i], NULL, NULL)) {
+                cargs_panic ("Benchmark input failed to parse");
+            }
+            double elapsed = now_ns() - start;
+            best           = (r == 0) ? elapsed : CARGS__MIN (best, elapsed);
+        }
+        printf ("%-10u %.0f\n", thread_counts[i], JOB_COUNT / (best / 1e9));
+    }
+
+    cargs_parser_cleanup (&schema);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Compares passing a large list of numbers as one comma separated token (CARGS_LISTOF_DELIMITED)
+ * with passing each number as a separate token (CARGS_LISTOF). delimited2 splits the same token
+ * with a set of two delimiters.
+ **************************************************************************************************/
+
+#define VALUE_COUNT  100000
+#define VALUE_LEN    8 // "0.12345,"
+#define REPEAT_COUNT 5
+
+static char delimited_value[VALUE_COUNT * VALUE_LEN + 1];
+static char separate_values[VALUE_COUNT][VALUE_LEN];
+static char* delimited_argv[] = { "bench", "-w", delimited_value, NULL };
+static char* separate_argv[VALUE_COUNT + 3];
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_parse (Cargs_TypeInterface interface, int argc, char** argv)
+{
+    double best = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        Cargs_ArrayList* list = cargs_add_arg ("w", "Weights", interface, NULL);
+
+        double start = now_ns();
+        if (!cargs_parse_input (argc, argv) || list->len != VALUE_COUNT) {
+            cargs_panic ("Benchmark input failed to parse");
+        }
+        double ns = (now_ns() - start) / VALUE_COUNT;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+
+        cargs_cleanup();
+    }
+    return best;
+}
+
+int main (void)
+{
+    char* cur = delimited_value;
+    for (unsigned i = 0; i < VALUE_COUNT; i++) {
+        snprintf (separate_values[i], VALUE_LEN, "0.%05u", i % 100000);
+        cur += sprintf (cur, "%s,", separate_values[i]);
+        separate_argv[i + 2] = separate_values[i];
+    }
+    cur[-1]          = '\0'; // No delimiter after the last value
+    separate_argv[0] = "bench";
+    separate_argv[1] = "-w";
+
+    printf ("%-12s %s\n", "syntax", "ns/value");
+    printf ("%-12s %.2f\n", "separate",
+            bench_parse (CARGS_LISTOF (Double), VALUE_COUNT + 2, separate_argv));
+    printf ("%-12s %.2f\n", "delimited",
+            bench_parse (CARGS_LISTOF_DELIMITED (Double, ","), 3, delimited_argv));
+    printf ("%-12s %.2f\n", "delimited2",
+            bench_parse (CARGS_LISTOF_DELIMITED (Double, ";,"), 3, delimited_argv));
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Compares the Double parser with strtod (used with an end pointer check, as a strict parser must),
+ * for typical command line values and for ones which need the slow path.
+ **************************************************************************************************/
+
+#define ITERATION_COUNT 2000000
+#define REPEAT_COUNT    5
+
+static const char* tokens[] = {
+    "1", "0.5", "-0.001", "3.14159", "1e-6", "123456.789",
+    "0.30000000000000004",    // Slow path: significant digits do not fit in 53 bits
+    "1.7976931348623157e308", // Slow path: power of ten is not exact
+};
+
+static volatile double sink; // Keeps the compiler from removing the parsing
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static bool strtod_parse (const char* input, double* out)
+{
+    char* end = NULL;
+    *out      = strtod (input, &end);
+    return end != input && *end == '\0';
+}
+
+static bool cargs_parse (const char* input, double* out)
+{
+    Cargs_TypeInterface interface = Double;
+    interface.CARGS__value        = out;
+    return interface.parse_string (&interface, input, CARGS__SLICE_OF (out, sizeof (double)));
+}
+
+static double bench (bool (*parse) (const char*, double*), const char* token)
+{
+    double best = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        double start = now_ns();
+        for (unsigned i = 0; i < ITERATION_COUNT; i++) {
+            double value = 0;
+            parse (token, &value);
+            sink = value;
+        }
+        double ns = (now_ns() - start) / ITERATION_COUNT;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+    }
+    return best;
+}
+
+int main (void)
+{
+    printf ("%-24s %-14s %s\n", "token", "strtod ns", "cargs ns");
+    for (unsigned i = 0; i < CARGS__ARRAY_LEN (tokens); i++) {
+        printf ("%-24s %-14.2f %.2f\n", tokens[i], bench (strtod_parse, tokens[i]),
+                bench (cargs_parse, tokens[i]));
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Compares the integer parsers with strtol/strtoll, for short and long tokens. strtol based parsing
+ * is done the way a strict parser must use it: with an end pointer and errno check.
+ **************************************************************************************************/
+
+#define ITERATION_COUNT 5000000
+#define REPEAT_COUNT    5
+
+static const char* tokens[] = {
+    "7", "42", "-1234", "65535", "2147483647", "-9223372036854775807", "18446744073709551615",
+};
+
+static volatile int64_t sink; // Keeps the compiler from removing the parsing
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static bool strtoll_parse (const char* input, int64_t* out)
+{
+    char* end = NULL;
+    errno     = 0;
+    *out      = strtoll (input, &end, 10);
+    return errno != ERANGE && end != input && *end == '\0';
+}
+
+static bool cargs_parse (const char* input, int64_t* out)
+{
+    Cargs_TypeInterface interface = Int64;
+    interface.CARGS__value        = out;
+    return interface.parse_string (&interface, input, CARGS__SLICE_OF (out, sizeof (int64_t)));
+}
+
+static double bench (bool (*parse) (const char*, int64_t*), const char* token)
+{
+    double best = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        double start = now_ns();
+        for (unsigned i = 0; i < ITERATION_COUNT; i++) {
+            int64_t value = 0;
+            parse (token, &value);
+            sink = value;
+        }
+        double ns = (now_ns() - start) / ITERATION_COUNT;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+    }
+    return best;
+}
+
+int main (void)
+{
+    printf ("%-22s %-14s %s\n", "token", "strtoll ns", "cargs ns");
+    for (unsigned i = 0; i < CARGS__ARRAY_LEN (tokens); i++) {
+        printf ("%-22s %-14.2f %.2f\n", tokens[i], bench (strtoll_parse, tokens[i]),
+                bench (cargs_parse, tokens[i]));
+    }
+    return 0;
+}
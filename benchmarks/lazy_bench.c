@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Compares eager and lazy (CARGS_LAZY) conversion of arguments with an expensive type, when the
+ * program reads only one of them. The type builds a table from its value, standing in for types
+ * which load a file or build a lookup table.
+ **************************************************************************************************/
+
+#define ARG_COUNT    64
+#define TABLE_LEN    4096
+#define REPEAT_COUNT 5
+
+typedef struct {
+    uint32_t items[TABLE_LEN];
+} Table;
+
+static bool table_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                Cargs_Slice out)
+{
+    uint32_t seed = 0;
+    if (!cargs_int_parse_string (self, input, CARGS__SLICE_OF (&seed, sizeof (seed)))) {
+        return false;
+    }
+
+    Table* table = (Table*)out.address;
+    for (unsigned i = 0; i < TABLE_LEN; i++) {
+        seed            = seed * 1664525u + 1013904223u;
+        table->items[i] = seed;
+    }
+    return true;
+}
+
+static Cargs_TypeInterface TableInterface = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .format_help  = "(seed)",
+    .type_size    = sizeof (Table),
+    .parse_string = table_parse_string,
+};
+
+static char names[ARG_COUNT][16];
+static char* argv[ARG_COUNT * 2 + 2];
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_parse (Cargs_TypeInterface interface)
+{
+    double best = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        for (unsigned i = 0; i < ARG_COUNT; i++) {
+            CARGS__cargs_add_arg (names[i], "Table", interface, NULL, NULL, NULL);
+        }
+
+        double start = now_ns();
+        Table* table = NULL;
+        if (!cargs_parse_input (ARG_COUNT * 2 + 1, argv) ||
+            !(table = (Table*)CARGS__parser_get (&CARGS__default_parser, names[0]))) {
+            cargs_panic ("Benchmark input failed to parse");
+        }
+        double ns = now_ns() - start;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+
+        cargs_cleanup();
+    }
+    return best;
+}
+
+int main (void)
+{
+    argv[0] = "bench";
+    for (unsigned i = 0; i < ARG_COUNT; i++) {
+        snprintf (names[i], sizeof (names[i]), CARGS__ARGUMENT_PREFIX_CHAR "t%u", i);
+        argv[i * 2 + 1] = names[i];
+        argv[i * 2 + 2] = "12345";
+    }
+
+    printf ("%-8s %s (%d args, 1 read)\n", "mode", "ns/parse", ARG_COUNT);
+    printf ("%-8s %.0f\n", "eager", bench_parse (TableInterface));
+    printf ("%-8s %.0f\n", "lazy", bench_parse (CARGS_LAZY (TableInterface)));
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Measures the per token cost of cargs_parse_input as the number of registered arguments grows.
+ * Every argument is a list, so the same argument can appear any number of times in the command
+ * line. Names are looked up in the order they were added, so with a linear lookup the cost per
+ * token would grow with the argument count.
+ **************************************************************************************************/
+
+#define NAME_LEN     16
+#define MAX_ARGS     10000
+#define TOKEN_COUNT  200000 // Name, value pairs
+#define REPEAT_COUNT 5
+
+static char names[MAX_ARGS][NAME_LEN];
+static char* argv[TOKEN_COUNT + 2];
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_parse (unsigned arg_count)
+{
+    for (unsigned i = 0; i < arg_count; i++) {
+        snprintf (names[i], NAME_LEN, CARGS__ARGUMENT_PREFIX_CHAR "arg%u", i);
+        CARGS__cargs_add_arg (names[i], "Benchmark argument", CARGS_LISTOF (Integer), NULL, NULL,
+                              NULL);
+    }
+
+    argv[0] = "bench";
+    for (unsigned i = 0; i < TOKEN_COUNT; i += 2) {
+        argv[i + 1] = names[(i / 2) % arg_count];
+        argv[i + 2] = "1";
+    }
+    argv[TOKEN_COUNT + 1] = NULL;
+
+    double start = now_ns();
+    if (!cargs_parse_input (TOKEN_COUNT + 1, argv)) {
+        cargs_panic ("Benchmark input failed to parse");
+    }
+    double elapsed = now_ns() - start;
+
+    cargs_cleanup();
+    return elapsed / TOKEN_COUNT;
+}
+
+int main (void)
+{
+    static const unsigned arg_counts[] = { 10, 100, 1000, MAX_ARGS };
+
+    printf ("%-10s %s\n", "args", "ns/token");
+    for (unsigned i = 0; i < CARGS__ARRAY_LEN (arg_counts); i++) {
+        double best = 0;
+        for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+            double ns = bench_parse (arg_counts[i]);
+            best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+        }
+        printf ("%-10u %.2f\n", arg_counts[i], best);
+    }
+    return 0;
+}
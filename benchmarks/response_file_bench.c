@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Measures parsing of a response file with 1M input file paths, given to a list of StringView.
+ * Tokens are not copied, so the cost is mostly mapping the file and finding the line ends.
+ **************************************************************************************************/
+
+#define ENTRY_COUNT  1000000
+#define REPEAT_COUNT 5
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void write_response_file (const char* path, bool is_null_delimited)
+{
+    FILE* file = fopen (path, "w");
+    if (file == NULL) {
+        cargs_panic ("Cannot create response file");
+    }
+
+    char delimiter = is_null_delimited ? '\0' : '\n';
+    fprintf (file, CARGS__ARGUMENT_PREFIX_CHAR "I%c", delimiter);
+    for (unsigned i = 0; i < ENTRY_COUNT; i++) {
+        fprintf (file, "/data/inputs/batch-%04u/file-%07u.bin%c", i % 1000, i, delimiter);
+    }
+    fclose (file);
+}
+
+static double bench_parse (char* response_file_arg)
+{
+    Cargs_ArrayList* files = cargs_add_arg ("I", "Input files", CARGS_LISTOF (StringView), NULL);
+
+    char* argv[] = { "bench", response_file_arg, NULL };
+
+    double start = now_ns();
+    if (!cargs_parse_input (2, argv) || files->len != ENTRY_COUNT) {
+        cargs_panic ("Benchmark input failed to parse");
+    }
+    double elapsed = now_ns() - start;
+
+    cargs_cleanup();
+    return elapsed;
+}
+
+int main (void)
+{
+    static char path[] = "/tmp/cargs_bench_response_file";
+    static char response_file_arg[] = CARGS__RESPONSE_FILE_PREFIX_CHAR
+        "/tmp/cargs_bench_response_file";
+
+    printf ("%-10s %-10s %-10s %s\n", "mode", "entries", "ms", "ns/entry");
+    for (unsigned mode = 0; mode < 2; mode++) {
+        bool is_null_delimited = (mode == 1);
+        write_response_file (path, is_null_delimited);
+
+        double best = 0;
+        for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+            double ns = bench_parse (response_file_arg);
+            best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+        }
+        printf ("%-10s %-10u %-10.2f %.2f\n", is_null_delimited ? "null" : "newline", ENTRY_COUNT,
+                best / 1e6, best / ENTRY_COUNT);
+        remove (path);
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+DIRNAME=$(dirname $0)
+ROOT_PATH="."
+if [ $DIRNAME = "." ]; then
+    ROOT_PATH=".."
+fi
+OUTFILE=$ROOT_PATH/benchmarks/bench
+
+#===============================================================================
+# Build and run benchmarks
+#===============================================================================
+BENCH_SRC=(
+    "$ROOT_PATH/benchmarks/lookup_bench.c"
+    "$ROOT_PATH/benchmarks/response_file_bench.c"
+    "$ROOT_PATH/benchmarks/batch_bench.c"
+    "$ROOT_PATH/benchmarks/int_parse_bench.c"
+    "$ROOT_PATH/benchmarks/double_parse_bench.c"
+    "$ROOT_PATH/benchmarks/delimited_list_bench.c"
+    "$ROOT_PATH/benchmarks/lazy_bench.c"
+    "$ROOT_PATH/benchmarks/scaling_bench.c"
+    "$ROOT_PATH/benchmarks/type_bench.c"
+    "$ROOT_PATH/benchmarks/suggest_bench.c"
+)
+
+for cfile in ${BENCH_SRC[@]}; do
+    echo "Compiling '$cfile'.."
+    gcc -O2 -DNDEBUG               \
+        -Wall -Wextra $cfile       \
+        -pthread                   \
+        -o $OUTFILE || exit
+
+    ./$OUTFILE || exit
+done
+#===============================================================================
@@ -0,0 +1,140 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * End to end cost of every phase (registration, cargs_parse_input, validation, cargs_print_help
+ * and cargs_cleanup) as the number of registered arguments and the number of command line tokens
+ * grow. Validation is measured as the parsing of a command line without any argument, which only
+ * runs the checks done after tokenization. Results are printed as JSON, so they can be compared
+ * between runs; a cost which grows faster than the input (quadratic lookups or list growth) shows
+ * up as a growing per arg or per token time.
+ **************************************************************************************************/
+
+#define NAME_LEN     16
+#define MAX_ARGS     100000
+#define MAX_TOKENS   1000000
+#define REPEAT_COUNT 3
+
+static const unsigned arg_counts[]   = { 10, 100, 1000, 10000, MAX_ARGS };
+static const unsigned token_counts[] = { 10, 1000, 100000, MAX_TOKENS };
+
+static char names[MAX_ARGS][NAME_LEN];
+static char* argv[MAX_TOKENS + 2];
+static char* empty_argv[] = { "bench", NULL };
+
+typedef struct {
+    double register_ns;
+    double parse_ns;
+    double validate_ns;
+    double help_ns;
+    double cleanup_ns;
+} Result;
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static Result bench_once (unsigned arg_count, unsigned token_count, int null_fd)
+{
+    Result result = { 0 };
+
+    double start = now_ns();
+    for (unsigned i = 0; i < arg_count; i++) {
+        CARGS__cargs_add_arg (names[i], "Benchmark argument", CARGS_LISTOF (Integer), "0", NULL,
+                              NULL);
+    }
+    result.register_ns = now_ns() - start;
+
+    start = now_ns();
+    if (!cargs_parse_input (1, empty_argv)) {
+        cargs_panic ("Benchmark validation failed");
+    }
+    result.validate_ns = now_ns() - start;
+
+    argv[0] = "bench";
+    for (unsigned i = 0; i < token_count; i += 2) {
+        argv[i + 1] = names[(i / 2) % arg_count];
+        argv[i + 2] = "1";
+    }
+    argv[token_count + 1] = NULL;
+
+    start = now_ns();
+    if (!cargs_parse_input (token_count + 1, argv)) {
+        cargs_panic ("Benchmark input failed to parse");
+    }
+    result.parse_ns = now_ns() - start;
+
+    // Help (printed to stderr) goes to /dev/null, so only the formatting and writing is measured.
+    fflush (stderr);
+    int stderr_fd = dup (STDERR_FILENO);
+    dup2 (null_fd, STDERR_FILENO);
+    start = now_ns();
+    cargs_print_help();
+    fflush (stderr);
+    result.help_ns = now_ns() - start;
+    dup2 (stderr_fd, STDERR_FILENO);
+    close (stderr_fd);
+
+    start = now_ns();
+    cargs_cleanup();
+    result.cleanup_ns = now_ns() - start;
+
+    return result;
+}
+
+static Result bench (unsigned arg_count, unsigned token_count, int null_fd)
+{
+    Result best = bench_once (arg_count, token_count, null_fd);
+    for (unsigned r = 1; r < REPEAT_COUNT; r++) {
+        Result result    = bench_once (arg_count, token_count, null_fd);
+        best.register_ns = CARGS__MIN (best.register_ns, result.register_ns);
+        best.parse_ns    = CARGS__MIN (best.parse_ns, result.parse_ns);
+        best.validate_ns = CARGS__MIN (best.validate_ns, result.validate_ns);
+        best.help_ns     = CARGS__MIN (best.help_ns, result.help_ns);
+        best.cleanup_ns  = CARGS__MIN (best.cleanup_ns, result.cleanup_ns);
+    }
+    return best;
+}
+
+int main (void)
+{
+    int null_fd = open ("/dev/null", O_WRONLY);
+    if (null_fd < 0) {
+        perror ("Failed to open /dev/null");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < MAX_ARGS; i++) {
+        snprintf (names[i], NAME_LEN, CARGS__ARGUMENT_PREFIX_CHAR "arg%u", i);
+    }
+
+    printf ("{\n  \"benchmark\": \"scaling\",\n  \"unit\": \"ns\",\n  \"results\": [");
+    for (unsigned a = 0; a < CARGS__ARRAY_LEN (arg_counts); a++) {
+        for (unsigned t = 0; t < CARGS__ARRAY_LEN (token_counts); t++) {
+            unsigned args   = arg_counts[a];
+            unsigned tokens = token_counts[t];
+            Result r        = bench (args, tokens, null_fd);
+
+            printf ("%s\n    {\"args\": %u, \"tokens\": %u, \"register\": %.0f, "
+                    "\"register_per_arg\": %.2f, \"validate\": %.0f, \"validate_per_arg\": %.2f, "
+                    "\"parse\": %.0f, \"parse_per_token\": %.2f, \"help\": %.0f, "
+                    "\"help_per_arg\": %.2f, \"cleanup\": %.0f, \"cleanup_per_arg\": %.2f}",
+                    (a == 0 && t == 0) ? "" : ",", args, tokens, r.register_ns,
+                    r.register_ns / args, r.validate_ns, r.validate_ns / args, r.parse_ns,
+                    r.parse_ns / tokens, r.help_ns, r.help_ns / args, r.cleanup_ns,
+                    r.cleanup_ns / args);
+        }
+    }
+    printf ("\n  ]\n}\n");
+
+    close (null_fd);
+    return 0;
+}
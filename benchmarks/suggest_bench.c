@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Cost of matching the names which are not in the argument list, as the number of registered names
+ * grows: abbreviations (unique prefixes) and did-you-mean suggestions for typos, found by walking
+ * the name trie. The baseline for suggestions computes the edit distance to every name, which is
+ * what a suggestion costs without the trie. Names are random lowercase words of 6 to 14 chars, and
+ * every typo has one of the chars of a name replaced.
+ **************************************************************************************************/
+
+#define NAME_LEN     16
+#define MAX_ARGS     10000
+#define QUERY_COUNT  2000
+#define REPEAT_COUNT 3
+
+static char names[MAX_ARGS][NAME_LEN];
+static char typos[QUERY_COUNT][NAME_LEN];
+static char prefixes[QUERY_COUNT][NAME_LEN];
+static uint64_t random_state = 88172645463325252ull;
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t next_random (void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Optimal string alignment distance, as the trie walk computes it.
+static unsigned edit_distance (const char* a, const char* b)
+{
+    unsigned rows[3][NAME_LEN + 1];
+    size_t a_len = strlen (a);
+    size_t b_len = strlen (b);
+
+    for (size_t j = 0; j <= b_len; j++) {
+        rows[0][j] = (unsigned)j;
+    }
+    for (size_t i = 1; i <= a_len; i++) {
+        unsigned* row  = rows[i % 3];
+        unsigned* prev = rows[(i - 1) % 3];
+        row[0]         = (unsigned)i;
+        for (size_t j = 1; j <= b_len; j++) {
+            unsigned cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            row[j]        = CARGS__MIN (CARGS__MIN (row[j - 1], prev[j]) + 1, prev[j - 1] + cost);
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                row[j] = CARGS__MIN (row[j], rows[(i - 2) % 3][j - 2] + 1);
+            }
+        }
+    }
+    return rows[a_len % 3][b_len];
+}
+
+static const char* linear_suggest (unsigned arg_count, const char* token)
+{
+    unsigned best          = CARGS__MAX_SUGGESTION_DISTANCE + 1;
+    const char* suggestion = NULL;
+    for (unsigned i = 0; i < arg_count; i++) {
+        unsigned distance = edit_distance (token, names[i]);
+        if (distance < best) {
+            best       = distance;
+            suggestion = names[i];
+        }
+    }
+    return suggestion;
+}
+
+static void generate_names (void)
+{
+    for (unsigned i = 0; i < MAX_ARGS; i++) {
+        unsigned len = 6 + (unsigned)(next_random() % 9);
+        names[i][0]  = CARGS__ARGUMENT_PREFIX_CHAR[0];
+        for (unsigned c = 1; c < len; c++) {
+            names[i][c] = 'a' + (char)(next_random() % 26);
+        }
+        names[i][len] = '\0';
+    }
+}
+
+// Queries are made from the first arg_count names, so all of them have a match.
+static void generate_queries (unsigned arg_count)
+{
+    for (unsigned q = 0; q < QUERY_COUNT; q++) {
+        const char* name = names[next_random() % arg_count];
+        size_t len       = strlen (name);
+
+        strcpy (typos[q], name);
+        typos[q][1 + next_random() % (len - 1)] = 'a' + (char)(next_random() % 26);
+
+        memcpy (prefixes[q], name, len - 2);
+        prefixes[q][len - 2] = '\0';
+    }
+}
+
+int main (void)
+{
+    static const unsigned arg_counts[] = { 10, 100, 1000, MAX_ARGS };
+
+    generate_names();
+
+    printf ("%-10s %-16s %-16s %s\n", "args", "ns/abbreviation", "ns/suggestion",
+            "ns/suggestion (linear)");
+    for (unsigned a = 0; a < CARGS__ARRAY_LEN (arg_counts); a++) {
+        unsigned arg_count   = arg_counts[a];
+        Cargs_Parser* parser = &CARGS__default_parser;
+        for (unsigned i = 0; i < arg_count; i++) {
+            // Random names can repeat, and are left out if they do.
+            if (CARGS__find_by_name (parser, names[i]) == NULL) {
+                CARGS__cargs_add_arg (names[i], "Benchmark argument", Flag, "false", NULL, NULL);
+            }
+        }
+        generate_queries (arg_count);
+
+        double best[3] = { 0 };
+        unsigned found = 0;
+        for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+            double start = now_ns();
+            for (unsigned q = 0; q < QUERY_COUNT; q++) {
+                found += CARGS__find_by_token (parser, prefixes[q], strlen (prefixes[q])) != NULL;
+            }
+            double abbreviation_ns = now_ns() - start;
+
+            start = now_ns();
+            for (unsigned q = 0; q < QUERY_COUNT; q++) {
+                found += CARGS__suggest (parser, typos[q], strlen (typos[q])) != NULL;
+            }
+            double suggest_ns = now_ns() - start;
+
+            start = now_ns();
+            for (unsigned q = 0; q < QUERY_COUNT; q++) {
+                found += linear_suggest (arg_count, typos[q]) != NULL;
+            }
+            double linear_ns = now_ns() - start;
+
+            best[0] = (r == 0) ? abbreviation_ns : CARGS__MIN (best[0], abbreviation_ns);
+            best[1] = (r == 0) ? suggest_ns : CARGS__MIN (best[1], suggest_ns);
+            best[2] = (r == 0) ? linear_ns : CARGS__MIN (best[2], linear_ns);
+        }
+        if (found == 0) {
+            cargs_panic ("Benchmark queries found nothing");
+        }
+
+        printf ("%-10u %-16.1f %-16.1f %.1f\n", arg_count, best[0] / QUERY_COUNT,
+                best[1] / QUERY_COUNT, best[2] / QUERY_COUNT);
+        cargs_cleanup();
+    }
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Conversion throughput (million values per second) of every built-in type, and of custom types
+ * registered through the same interface, both as a single value (parse_string called on the
+ * argument, as cargs_parse_input does) and as a CARGS_LISTOF list parsed by cargs_parse_input.
+ * Inputs mix short, long and negative numbers and short and long paths. The libc based types
+ * (strtol, strtod, stpncpy) are the baselines any parser of a built-in type is compared with.
+ **************************************************************************************************/
+
+#define VALUE_COUNT  100000
+#define VALUE_LEN    160
+#define REPEAT_COUNT 5
+
+typedef enum {
+    INPUT_BOOLEAN,
+    INPUT_INTEGER,
+    INPUT_INT64,
+    INPUT_UNSIGNED,
+    INPUT_HEX,
+    INPUT_OCTAL,
+    INPUT_BINARY,
+    INPUT_DOUBLE,
+    INPUT_PATH,
+} InputKind;
+
+typedef struct {
+    const char* name;
+    const Cargs_TypeInterface* interface;
+    InputKind input;
+    bool has_list; // false for flags, which do not take values
+} TypeCase;
+
+static char values[VALUE_COUNT][VALUE_LEN];
+static char* argv[VALUE_COUNT + 3];
+static uint64_t random_state = 88172645463325252ull;
+
+// Baselines -------------------------------------------------------------------------------------
+static bool strtol_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                 Cargs_Slice out)
+{
+    CARGS_UNUSED (self);
+    char* end = NULL;
+    errno     = 0;
+    long v    = strtol (input, &end, 10);
+    if (end == input || *end != '\0' || errno != 0 || v < INT_MIN || v > INT_MAX) {
+        return false;
+    }
+    *(int*)out.address = (int)v;
+    return true;
+}
+
+static bool strtod_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                 Cargs_Slice out)
+{
+    CARGS_UNUSED (self);
+    char* end = NULL;
+    errno     = 0;
+    double v  = strtod (input, &end);
+    if (end == input || *end != '\0' || errno != 0) {
+        return false;
+    }
+    *(double*)out.address = v;
+    return true;
+}
+
+static bool stpncpy_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                  Cargs_Slice out)
+{
+    CARGS_UNUSED (self);
+    char* end = stpncpy ((char*)out.address, input, out.len - 1);
+    *end      = '\0';
+    return true;
+}
+
+static Cargs_TypeInterface StrtolInterface = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (int),
+    .format_help  = "(number)",
+    .parse_string = strtol_parse_string,
+};
+
+static Cargs_TypeInterface StrtodInterface = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (double),
+    .format_help  = "(decimal number)",
+    .parse_string = strtod_parse_string,
+};
+
+static Cargs_TypeInterface StpncpyInterface = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (Cargs_StringType),
+    .format_help  = "(text)",
+    .parse_string = stpncpy_parse_string,
+};
+// ------------------------------------------------------------------------------------------------
+
+static const TypeCase type_cases[] = {
+    { "Boolean", &Boolean, INPUT_BOOLEAN, true },
+    { "Flag", &Flag, INPUT_BOOLEAN, false },
+    { "Integer", &Integer, INPUT_INTEGER, true },
+    { "strtol", &StrtolInterface, INPUT_INTEGER, true },
+    { "Int64", &Int64, INPUT_INT64, true },
+    { "UInt64", &UInt64, INPUT_UNSIGNED, true },
+    { "Size", &Size, INPUT_UNSIGNED, true },
+    { "Hex", &Hex, INPUT_HEX, true },
+    { "Octal", &Octal, INPUT_OCTAL, true },
+    { "Binary", &Binary, INPUT_BINARY, true },
+    { "Double", &Double, INPUT_DOUBLE, true },
+    { "strtod", &StrtodInterface, INPUT_DOUBLE, true },
+    { "String", &String, INPUT_PATH, true },
+    { "stpncpy", &StpncpyInterface, INPUT_PATH, true },
+    { "StringView", &StringView, INPUT_PATH, true },
+};
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t next_random (void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Thirds of the values are short, long and negative (for the types which have a sign).
+static void generate_value (InputKind kind, unsigned i, char* out)
+{
+    uint64_t r     = next_random();
+    unsigned third = i % 3;
+    uint64_t small = r % 1000;
+
+    switch (kind) {
+    case INPUT_BOOLEAN:
+        strcpy (out, (r & 1) ? "true" : "false");
+        break;
+    case INPUT_INTEGER:
+        snprintf (out, VALUE_LEN, "%d",
+                  (third == 0) ? (int)small
+                               : ((third == 1) ? (int)(r % INT_MAX) : -(int)(r % INT_MAX)));
+        break;
+    case INPUT_INT64:
+        snprintf (out, VALUE_LEN, "%lld",
+                  (third == 0) ? (long long)small
+                               : ((third == 1) ? (long long)(r >> 1) : -(long long)(r >> 1)));
+        break;
+    case INPUT_UNSIGNED:
+        snprintf (out, VALUE_LEN, "%llu", (unsigned long long)((third == 0) ? small : r));
+        break;
+    case INPUT_HEX:
+        snprintf (out, VALUE_LEN, "0x%llx", (unsigned long long)((third == 0) ? small : r));
+        break;
+    case INPUT_OCTAL:
+        snprintf (out, VALUE_LEN, "0o%llo", (unsigned long long)((third == 0) ? small : r));
+        break;
+    case INPUT_BINARY: {
+        uint64_t v = (third == 0) ? small : r;
+        int len    = 64 - __builtin_clzll (v | 1);
+        out[0]     = '0';
+        out[1]     = 'b';
+        for (int b = 0; b < len; b++) {
+            out[2 + b] = '0' + ((v >> (len - 1 - b)) & 1);
+        }
+        out[2 + len] = '\0';
+    } break;
+    case INPUT_DOUBLE:
+        if (third == 0) {
+            snprintf (out, VALUE_LEN, "%.1f", (double)small / 10);
+        } else if (third == 1) {
+            snprintf (out, VALUE_LEN, "%.17g", (double)r / 3.0);
+        } else {
+            snprintf (out, VALUE_LEN, "%.6e", -(double)r / (double)(small + 1));
+        }
+        break;
+    case INPUT_PATH:
+        if (third == 0) {
+            snprintf (out, VALUE_LEN, "./file_%u.txt", (unsigned)small);
+        } else {
+            snprintf (out, VALUE_LEN,
+                      "/home/user/projects/project_%u/assets/textures/environment/"
+                      "level_%u/materials/surface_%llu.png",
+                      (unsigned)small, i, (unsigned long long)r);
+        }
+        break;
+    }
+}
+
+static void generate_values (InputKind kind)
+{
+    argv[0] = "bench";
+    argv[1] = CARGS__ARGUMENT_PREFIX_CHAR "v";
+    for (unsigned i = 0; i < VALUE_COUNT; i++) {
+        generate_value (kind, i, values[i]);
+        argv[i + 2] = values[i];
+    }
+    argv[VALUE_COUNT + 2] = NULL;
+}
+
+static double values_per_us (double ns)
+{
+    return (double)VALUE_COUNT / (ns / 1000.0);
+}
+
+// parse_string is called on the argument itself, as cargs_parse_input does, so types which use
+// their argument (Flag) work as they do in parsing.
+static double bench_scalar (const TypeCase* type_case)
+{
+    double best = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        CARGS__cargs_add_arg (CARGS__ARGUMENT_PREFIX_CHAR "v", "Value", *type_case->interface,
+                              (type_case->input == INPUT_BOOLEAN) ? "false" : NULL, NULL, NULL);
+        CARGS__Argument* arg = CARGS__find_by_name (&CARGS__default_parser,
+                                                    CARGS__ARGUMENT_PREFIX_CHAR "v");
+        Cargs_Slice out = CARGS__SLICE_OF (arg->interface.CARGS__value, arg->interface.type_size);
+
+        double start = now_ns();
+        for (unsigned i = 0; i < VALUE_COUNT; i++) {
+            if (!arg->interface.parse_string (&arg->interface, values[i], out)) {
+                fprintf (stderr, "%s: invalid value '%s'\n", type_case->name, values[i]);
+                cargs_panic ("Benchmark input failed to parse");
+            }
+        }
+        double ns = now_ns() - start;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+
+        cargs_cleanup();
+    }
+    return values_per_us (best);
+}
+
+static double bench_list (const TypeCase* type_case)
+{
+    Cargs_TypeInterface interface = *type_case->interface;
+    double best                   = 0;
+    for (unsigned r = 0; r < REPEAT_COUNT; r++) {
+        Cargs_ArrayList* list = CARGS__cargs_add_arg (CARGS__ARGUMENT_PREFIX_CHAR "v", "Values",
+                                                      CARGS_LISTOF (interface), NULL, NULL, NULL);
+
+        double start = now_ns();
+        if (!cargs_parse_input (VALUE_COUNT + 2, argv) || list->len != VALUE_COUNT) {
+            cargs_panic ("Benchmark input failed to parse");
+        }
+        double ns = now_ns() - start;
+        best      = (r == 0) ? ns : CARGS__MIN (best, ns);
+
+        cargs_cleanup();
+    }
+    return values_per_us (best);
+}
+
+int main (void)
+{
+    printf ("%-12s %-16s %s\n", "type", "Mvalues/s", "Mvalues/s (list)");
+    for (unsigned i = 0; i < CARGS__ARRAY_LEN (type_cases); i++) {
+        const TypeCase* type_case = &type_cases[i];
+
+        random_state = 88172645463325252ull; // Same values for the types compared
+        generate_values (type_case->input);
+
+        printf ("%-12s %-16.2f", type_case->name, bench_scalar (type_case));
+        if (type_case->has_list) {
+            printf (" %.2f\n", bench_list (type_case));
+        } else {
+            printf (" -\n");
+        }
+    }
+    return 0;
+}
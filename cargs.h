@@ -32,14 +32,14 @@
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <float.h>
+#include <limits.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-#ifdef CARGS_MAX_ARG_COUNT_OVERRIDE // This many arguments are allowed
-    #define CARGS__MAX_ARG_COUNT CARGS_MAX_ARG_COUNT_OVERRIDE
-#else
-    #define CARGS__MAX_ARG_COUNT 20 // This many arguments are allowed
-#endif                              // CARGS_MAX_ARG_COUNT_OVERRIDE
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
 
 #ifdef CARGS_MAX_NAME_LEN_OVERRIDE // null byte is not included
     #define CARGS__MAX_NAME_LEN CARGS_MAX_NAME_LEN_OVERRIDE
@@ -59,12 +59,24 @@
     #define CARGS_MAX_INPUT_VALUE_LEN 100 // null byte is not included
 #endif                                    // CARGS_MAX_INPUT_VALUE_LEN_OVERRIDE
 
+#ifdef CARGS_ARL_INLINE_SIZE_OVERRIDE // Bytes of values a list holds without allocating
+    #define CARGS__ARL_INLINE_SIZE CARGS_ARL_INLINE_SIZE_OVERRIDE
+#else
+    #define CARGS__ARL_INLINE_SIZE 32 // Bytes of values a list holds without allocating
+#endif                                // CARGS_ARL_INLINE_SIZE_OVERRIDE
+
 #ifdef CARGS_ARGUMENT_PREFIX_CHAR_OVERRIDE
     #define CARGS__ARGUMENT_PREFIX_CHAR CARGS_ARGUMENT_PREFIX_CHAR_OVERRIDE
 #else
     #define CARGS__ARGUMENT_PREFIX_CHAR "-"
 #endif // CARGS_ARGUMENT_PREFIX_CHAR_OVERRIDE
 
+#ifdef CARGS_RESPONSE_FILE_PREFIX_CHAR_OVERRIDE
+    #define CARGS__RESPONSE_FILE_PREFIX_CHAR CARGS_RESPONSE_FILE_PREFIX_CHAR_OVERRIDE
+#else
+    #define CARGS__RESPONSE_FILE_PREFIX_CHAR "@"
+#endif // CARGS_RESPONSE_FILE_PREFIX_CHAR_OVERRIDE
+
 #define CARGS_PARENT_OF(self, type, field) ((type*)((uintptr_t)self - offsetof (type, field)))
 
 #define CARGS_UNUSED(v)                    (void)(v)
@@ -81,20 +93,83 @@ typedef struct Cargs_TypeInterface {
                          // the fields will remain same as the Type the ArrayList will hold.
     bool CARGS__is_flag; // set true for 'flag' arguments which don't need a value from command line
     bool CARGS__allow_multiple;
+    bool (*CARGS__on_value) (void* value); // If set for a multiple value argument, values are not
+                                           // kept in a list, but passed to it as they are parsed.
+    const char* CARGS__delimiters; // If set for a list argument, a value can be split into many
+                                   // by any of these chars.
+    bool CARGS__is_lazy; // set true if the value is converted on first access (see CARGS_LAZY)
     /* -- Public fields -- */
     size_t type_size;
     char* format_help;
     bool (*parse_string) (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
+    // Optional. Compares two values, for conditions on the value of an argument. If NULL, values
+    // are compared byte by byte (values are zero initialized before they are parsed).
+    bool (*equals) (struct Cargs_TypeInterface* self, const void* a, const void* b);
+    // Optional. Only checks the syntax of input, without converting it. Used by lazy arguments so
+    // invalid values are still reported while parsing, and to accept a value which starts with
+    // CARGS__ARGUMENT_PREFIX_CHAR ('-inf' for example). Without it, only negative numbers can.
+    bool (*check_string) (struct Cargs_TypeInterface* self, const char* input);
 } Cargs_TypeInterface;
 
-#define CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT \
-    .CARGS__name = "", .CARGS__value = NULL, .CARGS__is_flag = false, .CARGS__allow_multiple = false
+#define CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT                                             \
+    .CARGS__name = "", .CARGS__value = NULL, .CARGS__is_flag = false,                      \
+    .CARGS__allow_multiple = false, .CARGS__on_value = NULL, .CARGS__delimiters = NULL,    \
+    .CARGS__is_lazy = false
+
+// Value of StringView arguments. Points into argv (or the default value) which must outlive it.
+typedef struct {
+    const char* str; // null terminated
+    size_t len;
+} Cargs_StringView;
+
+/* Allocator
+ * Every allocation of a parser (arguments, values, list buffers, the region of an arena owned by
+ * cargs, help message larger than the stack buffer and batch workers) goes through its allocator.
+ * Blocks must be aligned for any type (max_align_t). On failure NULL is returned, after which cargs
+ * panics, as it does when malloc fails. The allocator is passed as self, so it can be embedded in
+ * a struct which has its state (see CARGS_PARENT_OF).
+ */
+typedef struct Cargs_Allocator {
+    // Allocates (ptr is NULL, old_size is 0) or resizes a block of old_size bytes, like realloc.
+    void* (*reallocate) (struct Cargs_Allocator* self, void* ptr, size_t old_size, size_t new_size);
+    // Releases a block (never NULL) of size bytes.
+    void (*deallocate) (struct Cargs_Allocator* self, void* ptr, size_t size);
+    // true if it can be called from many threads at once. Batch parsing workers call an allocator
+    // which is not thread safe one at a time.
+    bool is_thread_safe;
+} Cargs_Allocator;
+
+typedef struct CARGS__Arena {
+    unsigned char* base; // NULL when arena mode is not in use
+    size_t size;
+    size_t used;
+    size_t last_offset; // Offset of the most recent allocation, which can be grown in place.
+    bool is_owned;      // true if region was allocated by cargs, false if supplied by the user.
+    Cargs_Allocator* allocator; // Of heap memory (NULL for the default one). Kept on cleanup.
+} CARGS__Arena;
+
+// Allocator which hands out blocks of a given buffer one after another (only the most recent one
+// can grow in place). Blocks are not released one by one; memory is reused by initializing the
+// allocator again. Not thread safe.
+typedef struct {
+    Cargs_Allocator allocator;
+    /* -- Private fields -- */
+    CARGS__Arena CARGS__arena;
+} Cargs_BumpAllocator;
 
 typedef struct {
     void* buffer;
     size_t item_size;
     size_t capacity;
     size_t len;
+    /* -- Private fields -- */
+    CARGS__Arena* CARGS__arena; // Arena where buffer is allocated. NULL if allocated on the heap.
+    // Small lists keep their values here (buffer then points into the list itself, so a list must
+    // not be copied). Buffer is allocated only when the values do not fit.
+    union {
+        max_align_t CARGS__align;
+        unsigned char CARGS__bytes[CARGS__ARL_INLINE_SIZE];
+    } CARGS__inline;
 } Cargs_ArrayList;
 
 #define CARGS__COL_GRAY       "\x1b[0;90m"
@@ -129,77 +204,537 @@ typedef struct {
         return ret;                                                                        \
     } while (0)
 
+typedef enum {
+    CARGS__CONDITION_UNKNOWN = 0, // Not yet evaluated, since the last parsing
+    CARGS__CONDITION_ENABLED,
+    CARGS__CONDITION_DISABLED,
+} CARGS__ConditionState;
+
+struct CARGS__StaticSchema;
+
+typedef struct CARGS__Argument {
+    char* name;
+    char* description;
+    char* default_value;
+    bool provided; // true if some value was provided. Always true for optional arguments.
+    bool dirty;    // true mean value was updated during parsing.
+    struct CARGS__StaticSchema* static_schema; // Schema of the argument, if it is in static storage
+                                               // (CARGS_STATIC_SCHEMA), otherwise NULL
+    unsigned index; // Position in the parser, which is also its bit in the group bitsets.
+    size_t format_help_len; // Length of format_help, with the list marking if it is a list
+    size_t value_count;     // Lists: number of values in the command line, counted before parsing
+    const char* lazy_input; // Lazy arguments: value which is not yet converted (NULL once it is)
+    bool is_lazy_failed;    // Lazy arguments: conversion of the last value failed
+    Cargs_TypeInterface interface;
+    struct {
+        bool (*is_enabled_fn) (void); // If NULL, arg is always enabled, otherwise its enabled when
+                                      // this predicate returns true.
+        char* description;            // Text which describes the condition for help message.
+        const char* when_name;        // If not NULL, arg is enabled when the when_name arg is
+        const char* when_value;       // enabled and its value is when_value.
+        struct CARGS__Argument* when_arg; // Resolved when_name. NULL till first evaluation.
+        void* when_parsed_value;          // when_value parsed as a value of when_arg.
+        CARGS__ConditionState state;      // Evaluated only once per parsing.
+    } condition;
+} CARGS__Argument;
+
+// Words of a bitset with a bit for every argument (by its index)
+#define CARGS__BITSET_WORDS(bit_count) (((bit_count) + 63) / 64)
+
+// Open addressing table is kept at most half full, so probe sequences stay short. Its size is a
+// power of 2 (as the capacity is), so a slot is found by masking the hash.
+#define CARGS__NAME_INDEX_SIZE(arg_capacity) ((size_t)(arg_capacity) * 2)
+
+// Bytes of the registry (see Cargs_Parser) for capacity arguments.
+#define CARGS__REGISTRY_SIZE(capacity)                                                   \
+    (sizeof (CARGS__Argument*) * (capacity) +                                            \
+     sizeof (unsigned) * CARGS__NAME_INDEX_SIZE (capacity) +                             \
+     sizeof (uint64_t) * CARGS__BITSET_WORDS (capacity))
+
+typedef enum {
+    CARGS_GROUP_MUTEX,        // At most one of the arguments can be given
+    CARGS_GROUP_TOGETHER,     // Either all or none of the arguments must be given
+    CARGS_GROUP_AT_LEAST_ONE, // At least one of the arguments must be given
+} Cargs_GroupKind;
+
+typedef struct {
+    Cargs_GroupKind kind;
+    uint64_t* members;   // Bitset, which covers the arguments added till the group was added
+    unsigned word_count; // Words in members
+} CARGS__Group;
+
+// Node of the prefix trie of the argument names, with a node for each char. Children of a node are
+// linked in the order of their chars, so walking the trie visits the names in sorted order.
+typedef struct {
+    uint32_t first_child;  // Index of the node, 0 if none (root is node 0, which is no one's child)
+    uint32_t next_sibling; // Index of the node, 0 if none
+    uint32_t arg;          // Index in CARGS__args + 1 of the name which ends here, 0 if none
+    uint32_t name_count;   // Number of names which go through this node
+    unsigned char ch;
+} CARGS__TrieNode;
+
+#ifdef CARGS_ENABLE_STATS
+    #define CARGS__MAX_STATS_TYPE_COUNT 16 // Types beyond this many are not counted
+
+typedef struct {
+    const char* format_help; // Identifies the type, along with parse_string
+    bool (*parse_string) (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
+    uint64_t parse_count; // Number of parse_string calls
+} Cargs_TypeStats;
+
+// Statistics of a parser, since it was zero initialized or cleaned up. Times are in nanoseconds and
+// add up over all the calls. Time of converting values is only in convert_ns, so the times of the
+// phases do not overlap. Collecting them costs two clock reads per converted value.
+typedef struct {
+    uint64_t register_ns; // Adding arguments
+    uint64_t tokenize_ns; // Going through the command line (and response files)
+    uint64_t convert_ns;  // Converting values (parse_string), including the default values
+    uint64_t validate_ns; // Checks done after the command line is parsed
+    uint64_t is_enabled_fn_count; // Number of is_enabled_fn calls
+    uint64_t list_growth_count;   // Number of times a list buffer was grown for more values
+    size_t value_bytes; // Bytes held by the values (including list buffers), when stats were taken
+    unsigned type_count;
+    Cargs_TypeStats types[CARGS__MAX_STATS_TYPE_COUNT];
+} Cargs_Stats;
+#endif // CARGS_ENABLE_STATS
+
+// Parser context, which owns the arguments and their values. Must be zero initialized.
+typedef struct {
+    /* -- Private fields -- */
+    unsigned int CARGS__arg_count;
+    unsigned int CARGS__arg_capacity; // Arguments which fit before the registry below is grown.
+    unsigned int CARGS__list_count;   // List arguments, which are presized before parsing
+    // Registry of the arguments, which is one allocation (starting at CARGS__args) holding all the
+    // three, grown together.
+    CARGS__Argument** CARGS__args;
+    unsigned int* CARGS__name_index; // Index in CARGS__args + 1, 0 if empty. 2 x capacity slots.
+    uint64_t* CARGS__given;          // Bitset of the arguments given in the command line
+    CARGS__TrieNode* CARGS__trie;    // Names of the arguments, for abbreviations and suggestions
+    unsigned int CARGS__trie_len;
+    unsigned int CARGS__trie_capacity;
+    // Registry and trie can be in the static storage of a schema (see CARGS_STATIC_SCHEMA), till
+    // they have to grow. Such storage is never freed.
+    bool CARGS__is_registry_static;
+    bool CARGS__is_trie_static;
+    Cargs_ArrayList* CARGS__response_files; // Slices of the mapped response files
+    bool CARGS__is_response_files_off;      // See cargs_parser_use_response_files
+    CARGS__Arena CARGS__arena;
+    bool CARGS__is_frozen; // Frozen parser is an immutable schema (see cargs_parser_freeze)
+    unsigned int CARGS__group_count;
+    unsigned int CARGS__group_capacity; // Groups which fit before CARGS__groups is grown
+    CARGS__Group* CARGS__groups;
+    size_t CARGS__help_name_width; // Widths of the help message columns, updated as arguments are
+    size_t CARGS__help_format_width; // added
+#ifdef CARGS_ENABLE_STATS
+    Cargs_Stats CARGS__stats;
+#endif // CARGS_ENABLE_STATS
+} Cargs_Parser;
+
+// Parser used by the functions which do not take a parser context.
+extern Cargs_Parser CARGS__default_parser;
+
 void cargs_panic (const char* msg);
 
+void* CARGS__parser_add_arg (Cargs_Parser* parser, const char* name, const char* description,
+                             Cargs_TypeInterface interface, const char* default_value,
+                             bool (*is_enabled_fn) (void), const char* cond_desciption);
 void* CARGS__cargs_add_arg (const char* name, const char* description,
                             Cargs_TypeInterface interface, const char* default_value,
                             bool (*is_enabled_fn) (void), const char* cond_desciption);
 
-#define CARGS__call_cargs_add_arg(name, description, interface, default_value, is_enabled_fn,     \
-                                  cond_desciption)                                                \
+#define CARGS__call_cargs_add_arg(parser, name, description, interface, default_value,            \
+                                  is_enabled_fn, cond_desciption)                                 \
     ({                                                                                            \
         static_assert (name != NULL, "must be string literal");                                   \
         static_assert (description != NULL, "must be string literal");                            \
         static_assert (default_value == NULL || default_value != NULL, "must be string literal"); \
         static_assert (cond_desciption == NULL || cond_desciption != NULL,                        \
                        "must be string literal");                                                 \
-        CARGS__cargs_add_arg (CARGS__ARGUMENT_PREFIX_CHAR name, description, interface,           \
-                              default_value, is_enabled_fn, cond_desciption);                     \
+        CARGS__parser_add_arg (parser, CARGS__ARGUMENT_PREFIX_CHAR name, description, interface,  \
+                               default_value, is_enabled_fn, cond_desciption);                    \
     })
 
-#define cargs_add_arg(name, description, interface, default_value) \
-    CARGS__call_cargs_add_arg (name, description, interface, default_value, NULL, NULL)
+#define cargs_parser_add_arg(parser, name, description, interface, default_value) \
+    CARGS__call_cargs_add_arg (parser, name, description, interface, default_value, NULL, NULL)
+
+#define cargs_parser_add_cond_arg(parser, is_enabled_fn, name, description, interface,     \
+                                  default_value)                                           \
+    CARGS__call_cargs_add_arg (parser, name, description, interface, default_value,        \
+                               is_enabled_fn, NULL)
+
+#define cargs_parser_add_cond_arg_d(parser, is_enabled_fn, cond_desciption, name, description, \
+                                    interface, default_value)                                  \
+    CARGS__call_cargs_add_arg (parser, name, description, interface, default_value,            \
+                               is_enabled_fn, cond_desciption)
+
+void* CARGS__parser_add_when_arg (Cargs_Parser* parser, const char* when_name,
+                                  const char* when_value, const char* name,
+                                  const char* description, Cargs_TypeInterface interface,
+                                  const char* default_value);
+
+// Adds an argument which is enabled only when the when_name argument is enabled and has the
+// when_value value. Conditions can be chained, but must not form a cycle.
+#define cargs_parser_add_when_arg(parser, when_name, when_value, name, description, interface,    \
+                                  default_value)                                                \
+    ({                                                                                          \
+        static_assert (when_name != NULL, "must be string literal");                            \
+        static_assert (when_value != NULL, "must be string literal");                           \
+        static_assert (name != NULL, "must be string literal");                                 \
+        static_assert (description != NULL, "must be string literal");                          \
+        static_assert (default_value == NULL || default_value != NULL, "must be string literal"); \
+        CARGS__parser_add_when_arg (parser, CARGS__ARGUMENT_PREFIX_CHAR when_name, when_value,  \
+                                    CARGS__ARGUMENT_PREFIX_CHAR name, description, interface,   \
+                                    default_value);                                             \
+    })
+
+void CARGS__parser_add_group (Cargs_Parser* parser, Cargs_GroupKind kind,
+                              const char* const* names, size_t count);
 
-#define cargs_add_cond_arg(is_enabled_fn, name, description, interface, default_value) \
-    CARGS__call_cargs_add_arg (name, description, interface, default_value, is_enabled_fn, NULL)
+// Adds a group of (already added) arguments, by their names, whose presence in the command line is
+// checked after parsing. For example, exactly one of -e and -d:
+//  cargs_add_group (CARGS_GROUP_MUTEX, "e", "d");
+//  cargs_add_group (CARGS_GROUP_AT_LEAST_ONE, "e", "d");
+#define cargs_parser_add_group(parser, kind, ...)                                         \
+    CARGS__parser_add_group (parser, kind, (const char* const[]){ __VA_ARGS__ },          \
+                             sizeof ((const char* const[]){ __VA_ARGS__ }) / sizeof (char*))
+#define cargs_add_group(kind, ...) \
+    cargs_parser_add_group (&CARGS__default_parser, kind, __VA_ARGS__)
 
-#define cargs_add_cond_arg_d(is_enabled_fn, cond_desciption, name, description, interface, \
-                             default_value)                                                \
-    CARGS__call_cargs_add_arg (name, description, interface, default_value, is_enabled_fn, \
-                               cond_desciption)
+#define cargs_add_arg(name, description, interface, default_value) \
+    cargs_parser_add_arg (&CARGS__default_parser, name, description, interface, default_value)
+
+#define cargs_add_cond_arg(is_enabled_fn, name, description, interface, default_value)       \
+    cargs_parser_add_cond_arg (&CARGS__default_parser, is_enabled_fn, name, description,     \
+                               interface, default_value)
+
+#define cargs_add_cond_arg_d(is_enabled_fn, cond_desciption, name, description, interface,   \
+                             default_value)                                                  \
+    cargs_parser_add_cond_arg_d (&CARGS__default_parser, is_enabled_fn, cond_desciption, name, \
+                                 description, interface, default_value)
+
+#define cargs_add_when_arg(when_name, when_value, name, description, interface, default_value) \
+    cargs_parser_add_when_arg (&CARGS__default_parser, when_name, when_value, name, description, \
+                               interface, default_value)
+
+/* Static schema
+ * A schema is a X-macro list of arguments. Its values and defaults live in static storage which is
+ * materialized at compile time, so adding the schema needs no parsing of default values. Storage
+ * for the argument registry and the name trie is static too, so adding the schema to a parser
+ * without arguments needs no allocation (parser only allocates once more arguments are added to
+ * it). Each entry is one of:
+ *  ARG  (field, name, description, interface, C type, default value, default value string)
+ *  LIST (field, name, description, interface)
+ * Non list arguments with a NULL default value string are required (default value is then only a
+ * placeholder), list arguments are always required. C type must be of the size of the values of
+ * the interface (type_size), adding the schema is an error otherwise. Values are reset to the
+ * defaults whenever the schema is added. Schema can only be added to one parser at a time, adding
+ * it again before that parser is cleaned up is an error. Example:
+ *
+ *  #define APP_ARGS(ARG, LIST)                                              \
+ *      ARG (verbose, "v", "Verbose output", Flag, bool, false, "false")     \
+ *      ARG (count, "n", "Number of items", Integer, int, 0, NULL)           \
+ *      LIST (files, "I", "Input files", String)
+ *
+ *  CARGS_STATIC_SCHEMA (app, APP_ARGS)
+ *  ...
+ *  cargs_add_static_schema (app); // or cargs_parser_add_static_schema (parser, app)
+ *  cargs_parse_input (argc, argv);
+ *  printf ("%d %d %zu\n", app.verbose, app.count, app.files.len);
+ */
+typedef struct {
+    const char* name;
+    const char* description;
+    const Cargs_TypeInterface* interface;
+    const char* default_value;
+    bool is_list;
+    size_t value_offset; // Offset of the value in the schema values struct
+    size_t type_size;    // Size of the C type of the value (0 for lists), checked with interface
+} Cargs_StaticArg;
+
+// Static state of a schema, kept along with its values.
+typedef struct CARGS__StaticSchema {
+    CARGS__Argument* args;      // One for each argument of the schema
+    void* registry;             // Registry (see Cargs_Parser) for twice as many arguments
+    CARGS__TrieNode* trie;      // Trie with room for all the names of the schema
+    unsigned trie_capacity;     // Nodes in trie
+    const void* initial_values; // Values with the defaults, copied to the values on add
+    size_t values_size;
+    bool is_in_use; // true from when the schema is added, till its parser is cleaned up
+} CARGS__StaticSchema;
+
+#define CARGS__SCHEMA_FIELD(field, name, description, interface, type, ...) type field;
+#define CARGS__SCHEMA_LIST_FIELD(field, name, description, interface)    Cargs_ArrayList field;
+
+#define CARGS__SCHEMA_VALUE(field, name, description, interface, type, value, ...) .field = value,
+#define CARGS__SCHEMA_LIST_VALUE(field, name, description, interface)             .field = { 0 },
+
+#define CARGS__SCHEMA_ARG(field, name, description, interface, type, value, default_value)     \
+    { CARGS__ARGUMENT_PREFIX_CHAR name, description, &interface, default_value, false,         \
+      offsetof (CARGS__SchemaValues, field), sizeof (type) },
+#define CARGS__SCHEMA_LIST_ARG(field, name, description, interface)                            \
+    { CARGS__ARGUMENT_PREFIX_CHAR name, description, &interface, NULL, true,                   \
+      offsetof (CARGS__SchemaValues, field), 0 },
+
+// Inserting a name makes room for its chars and a node more, so a trie of 1 + the sizes (with the
+// null byte) of all the names never has to grow.
+#define CARGS__SCHEMA_NAME_SIZE(field, name, ...) +sizeof (CARGS__ARGUMENT_PREFIX_CHAR name)
+
+#define CARGS_STATIC_SCHEMA(schema, list)                                                      \
+    static struct {                                                                            \
+        list (CARGS__SCHEMA_FIELD, CARGS__SCHEMA_LIST_FIELD)                                   \
+    } schema = { list (CARGS__SCHEMA_VALUE, CARGS__SCHEMA_LIST_VALUE) };                       \
+    static void schema##__CARGS__add (Cargs_Parser* parser)                                    \
+    {                                                                                          \
+        typedef __typeof__ (schema) CARGS__SchemaValues;                                       \
+        static const CARGS__SchemaValues initial_values = {                                    \
+            list (CARGS__SCHEMA_VALUE, CARGS__SCHEMA_LIST_VALUE)                               \
+        };                                                                                     \
+        static const Cargs_StaticArg args[] = { list (CARGS__SCHEMA_ARG,                       \
+                                                      CARGS__SCHEMA_LIST_ARG) };               \
+        enum { CARGS__ARG_COUNT = sizeof (args) / sizeof (args[0]) };                          \
+        static CARGS__Argument storage[CARGS__ARG_COUNT];                                      \
+        static uint64_t registry[(CARGS__REGISTRY_SIZE (2 * CARGS__ARG_COUNT) + 7) / 8];       \
+        static CARGS__TrieNode trie[1 list (CARGS__SCHEMA_NAME_SIZE,                           \
+                                            CARGS__SCHEMA_NAME_SIZE)];                         \
+        static CARGS__StaticSchema static_schema = {                                           \
+            storage, registry, trie, sizeof (trie) / sizeof (trie[0]),                         \
+            &initial_values, sizeof (initial_values), false                                    \
+        };                                                                                     \
+        CARGS__add_static_args (parser, args, CARGS__ARG_COUNT, &static_schema, &schema);      \
+    }
 
+void CARGS__add_static_args (Cargs_Parser* parser, const Cargs_StaticArg* args, size_t count,
+                             CARGS__StaticSchema* schema, void* values);
+
+#define cargs_parser_add_static_schema(parser, schema) schema##__CARGS__add (parser)
+#define cargs_add_static_schema(schema) \
+    cargs_parser_add_static_schema (&CARGS__default_parser, schema)
+
+void cargs_parser_use_arena (Cargs_Parser* parser, void* buffer, size_t size);
+void cargs_parser_use_allocator (Cargs_Parser* parser, Cargs_Allocator* allocator);
+void cargs_parser_cleanup (Cargs_Parser* parser);
+bool cargs_parser_parse_input (Cargs_Parser* parser, int argc, char** argv);
+void cargs_parser_print_help (Cargs_Parser* parser);
+size_t cargs_parser_format_help (Cargs_Parser* parser, char* buffer, size_t size);
+void cargs_parser_freeze (Cargs_Parser* parser);
+
+// Response files are on by default: a token '@file' is replaced by the tokens in the file, and
+// '@@text' is the token '@text'. When off, tokens starting with '@' are as any other token. Must be
+// set before the parser is frozen, and is on again after cleanup.
+void cargs_parser_use_response_files (Cargs_Parser* parser, bool is_on);
+
+// Writes to names (at most size of them), in sorted order, the names of the arguments which start
+// with prefix. prefix is as in the command line, starting with CARGS__ARGUMENT_PREFIX_CHAR. Returns
+// the number of such arguments, so not all of them were written if it is > size.
+size_t cargs_parser_complete (Cargs_Parser* parser, const char* prefix, const char** names,
+                              size_t size);
+
+void* CARGS__parser_get (Cargs_Parser* parser, const char* name);
+
+// Returns the address of the value of the named argument (same as was returned when it was added),
+// or NULL if there is no such argument. Value of a lazy argument is converted on the first call,
+// after which it is reused; NULL is returned if the conversion fails.
+#define cargs_parser_get(parser, name) CARGS__parser_get (parser, CARGS__ARGUMENT_PREFIX_CHAR name)
+#define cargs_get(name)                cargs_parser_get (&CARGS__default_parser, name)
+
+bool CARGS__parser_is_enabled (Cargs_Parser* parser, const char* name);
+
+// true if the named argument exists and its condition (if any) is met. Result is evaluated once
+// after parsing and then reused.
+#define cargs_parser_is_enabled(parser, name) \
+    CARGS__parser_is_enabled (parser, CARGS__ARGUMENT_PREFIX_CHAR name)
+#define cargs_is_enabled(name) cargs_parser_is_enabled (&CARGS__default_parser, name)
+
+#ifdef CARGS_ENABLE_STATS
+// Returns a copy of the statistics of the parser (see Cargs_Stats).
+Cargs_Stats cargs_parser_get_stats (Cargs_Parser* parser);
+Cargs_Stats cargs_get_stats (void);
+#endif // CARGS_ENABLE_STATS
+
+#ifdef CARGS_ENABLE_BATCH_PARSE
+/* Batch parsing
+ * Parses many argv vectors against one frozen parser (the schema), on a pool of worker threads.
+ * Each worker has its own copy of the arguments, so the schema is never modified. Argument
+ * callbacks (is_enabled_fn, stream on_value_fn, parse_string of custom types) and on_result are
+ * called from the worker threads, so must be thread safe. Workers allocate through the allocator
+ * of the schema, which they call one at a time if it is not thread safe (see is_thread_safe of
+ * Cargs_Allocator). Requires linking with pthread.
+ */
+typedef struct {
+    int argc;
+    char** argv;
+    bool is_ok; // Set by cargs_parse_batch. true if argv was parsed successfully.
+} Cargs_BatchJob;
+
+// Called, from a worker thread, after a job is parsed. Values of the job are accessed with
+// cargs_parser_get (result, name) and are valid only till the callback returns.
+typedef void (*Cargs_BatchResultFn) (size_t job_index, Cargs_Parser* result, void* user_data);
+
+// thread_count of 0 uses one thread per online CPU. Returns true if all jobs were parsed
+// successfully. on_result can be NULL, if only the status of the jobs is of interest.
+bool cargs_parse_batch (const Cargs_Parser* schema, Cargs_BatchJob* jobs, size_t job_count,
+                        unsigned thread_count, Cargs_BatchResultFn on_result, void* user_data);
+#endif // CARGS_ENABLE_BATCH_PARSE
+
+void cargs_use_arena (void* buffer, size_t size);
+void cargs_use_allocator (Cargs_Allocator* allocator);
+void cargs_use_response_files (bool is_on);
 void cargs_cleanup();
 bool cargs_parse_input (int argc, char** argv);
 void cargs_print_help();
 
+// Writes the help message (same as printed by cargs_print_help) into buffer, which is always null
+// terminated (if size > 0). Like snprintf, returns the length of the whole message, so the message
+// was cut short if the returned length is >= size.
+size_t cargs_format_help (char* buffer, size_t size);
+size_t cargs_complete (const char* prefix, const char** names, size_t size);
+
+// Allocator of the parsers which were not given one (NULL restores malloc, realloc & free). Must be
+// set before any parser allocates.
+void cargs_set_default_allocator (Cargs_Allocator* allocator);
+
+// Returns the allocator, which is &bump->allocator.
+Cargs_Allocator* cargs_bump_allocator_init (Cargs_BumpAllocator* bump, void* buffer, size_t size);
+
 bool cargs_bool_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
 bool cargs_int_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
+bool cargs_int64_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                               Cargs_Slice out);
+bool cargs_uint64_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                Cargs_Slice out);
+bool cargs_size_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
+bool cargs_hex_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
+bool cargs_octal_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                               Cargs_Slice out);
+bool cargs_binary_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                Cargs_Slice out);
 bool cargs_string_parse_string (struct Cargs_TypeInterface* self, const char* input,
                                 Cargs_Slice out);
+bool cargs_string_view_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                     Cargs_Slice out);
 bool cargs_flag_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out);
 bool cargs_double_parse_string (struct Cargs_TypeInterface* self, const char* input,
                                 Cargs_Slice out);
 
+// Check the value the same way as the parse_string of the type, without writing it (see
+// check_string), so invalid values of lazy arguments are reported while parsing.
+bool cargs_bool_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_int_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_int64_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_uint64_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_size_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_hex_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_octal_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_binary_check_string (struct Cargs_TypeInterface* self, const char* input);
+bool cargs_double_check_string (struct Cargs_TypeInterface* self, const char* input);
+
+bool cargs_string_view_equals (struct Cargs_TypeInterface* self, const void* a, const void* b);
+bool cargs_double_equals (struct Cargs_TypeInterface* self, const void* a, const void* b);
+
 void* cargs_arl_pop (Cargs_ArrayList* arl);
 
-#define CARGS_LISTOF(ti)                                                        \
-    (assert (!ti.CARGS__is_flag), (Cargs_TypeInterface){                        \
-                                      .CARGS__name           = ti.CARGS__name,  \
-                                      .CARGS__is_flag        = false,           \
-                                      .CARGS__allow_multiple = true,            \
-                                      .format_help           = ti.format_help,  \
-                                      .type_size             = ti.type_size,    \
-                                      .parse_string          = ti.parse_string, \
-                                  })
+#define CARGS_LISTOF(ti)                                                                           \
+    (assert (!ti.CARGS__is_flag), (Cargs_TypeInterface){                                           \
+         .CARGS__name           = ti.CARGS__name,                                                  \
+         .CARGS__value          = NULL,                                                            \
+         .CARGS__is_flag        = false,                                                           \
+         .CARGS__allow_multiple = true,                                                            \
+         .CARGS__on_value       = NULL,                                                            \
+         .CARGS__delimiters     = NULL,                                                            \
+         .CARGS__is_lazy        = false,                                                           \
+         .type_size             = ti.type_size,                                                    \
+         .format_help           = ti.format_help,                                                  \
+         .parse_string          = ti.parse_string,                                                 \
+         .equals                = NULL,                                                            \
+         .check_string          = ti.check_string,                                                 \
+     })
+
+// List argument, where one value in the command line can have many values separated by any of the
+// chars in delimiters (a string literal). For example CARGS_LISTOF_DELIMITED (Double, ",") accepts
+// '-w 0.1,0.2,0.3'. Values are copied while parsing, so StringView is not supported.
+#define CARGS_LISTOF_DELIMITED(ti, delimiters)                                                     \
+    (assert (!ti.CARGS__is_flag), assert (ti.parse_string != cargs_string_view_parse_string),      \
+     (Cargs_TypeInterface){                                                                        \
+         .CARGS__name           = ti.CARGS__name,                                                  \
+         .CARGS__value          = NULL,                                                            \
+         .CARGS__is_flag        = false,                                                           \
+         .CARGS__allow_multiple = true,                                                            \
+         .CARGS__on_value       = NULL,                                                            \
+         .CARGS__delimiters     = delimiters,                                                      \
+         .CARGS__is_lazy        = false,                                                           \
+         .type_size             = ti.type_size,                                                    \
+         .format_help           = ti.format_help,                                                  \
+         .parse_string          = ti.parse_string,                                                 \
+         .equals                = NULL,                                                            \
+         .check_string          = ti.check_string,                                                 \
+     })
+
+// Argument whose value is converted (parse_string) on its first access through cargs_get, instead
+// of while parsing. Useful for types whose conversion is expensive (loading a file for example) and
+// is not needed on every run. Parsing only records the value (which must outlive the access, like
+// argv does) and calls check_string, if the type has one. Otherwise an invalid value (including an
+// invalid default value) is reported on access, when cargs_get returns NULL.
+#define CARGS_LAZY(ti)                                                                             \
+    (assert (!ti.CARGS__is_flag), assert (!ti.CARGS__allow_multiple),                              \
+     (Cargs_TypeInterface){                                                                        \
+         .CARGS__name           = ti.CARGS__name,                                                  \
+         .CARGS__value          = NULL,                                                            \
+         .CARGS__is_flag        = false,                                                           \
+         .CARGS__allow_multiple = false,                                                           \
+         .CARGS__on_value       = NULL,                                                            \
+         .CARGS__delimiters     = NULL,                                                            \
+         .CARGS__is_lazy        = true,                                                            \
+         .type_size             = ti.type_size,                                                    \
+         .format_help           = ti.format_help,                                                  \
+         .parse_string          = ti.parse_string,                                                 \
+         .equals                = ti.equals,                                                       \
+         .check_string          = ti.check_string,                                                 \
+     })
+
+// Multiple values argument, where each value is passed to on_value_fn (bool (*) (void* value)) as
+// soon as it is parsed, instead of being collected in a list. Returning false from on_value_fn
+// fails the parsing. Default value (if any) is passed after parsing, if no value was provided.
+#define CARGS_STREAMOF(ti, on_value_fn)                                                            \
+    (assert (!ti.CARGS__is_flag), (Cargs_TypeInterface){                                           \
+         .CARGS__name           = ti.CARGS__name,                                                  \
+         .CARGS__value          = NULL,                                                            \
+         .CARGS__is_flag        = false,                                                           \
+         .CARGS__allow_multiple = true,                                                            \
+         .CARGS__on_value       = on_value_fn,                                                     \
+         .CARGS__delimiters     = NULL,                                                            \
+         .CARGS__is_lazy        = false,                                                           \
+         .type_size             = ti.type_size,                                                    \
+         .format_help           = ti.format_help,                                                  \
+         .parse_string          = ti.parse_string,                                                 \
+         .equals                = NULL,                                                            \
+         .check_string          = ti.check_string,                                                 \
+     })
 
 #ifdef CARGS_IMPLEMENTATION
 
-typedef struct CARGS__Argument {
-    char* name;
-    char* description;
-    char* default_value;
-    bool provided; // true if some value was provided. Always true for optional arguments.
-    bool dirty;    // true mean value was updated during parsing.
-    Cargs_TypeInterface interface;
-    struct {
-        bool (*is_enabled_fn) (void); // If NULL, arg is always enabled, otherwise its enabled when
-                                      // this predicate returns true.
-        char* description;            // Text which describes the condition for help message.
-    } condition;
-} CARGS__Argument;
+    #if !defined(CARGS_DISABLE_RESPONSE_FILES) && (defined(__unix__) || defined(__APPLE__))
+        #define CARGS__RESPONSE_FILES_ENABLED
+        #include <fcntl.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <unistd.h>
+    #endif // CARGS_DISABLE_RESPONSE_FILES
+
+    #include <stdarg.h>
 
-unsigned int CARGS__arg_list_count = 0;
-CARGS__Argument* CARGS__arg_list[CARGS__MAX_ARG_COUNT];
+    #ifdef CARGS_ENABLE_BATCH_PARSE
+        #include <pthread.h>
+        #include <unistd.h>
+    #endif // CARGS_ENABLE_BATCH_PARSE
+
+    #ifdef CARGS_ENABLE_STATS
+        #include <time.h>
+        #define CARGS__STATS(...) __VA_ARGS__ // Code which is only there to collect statistics
+    #else
+        #define CARGS__STATS(...)
+    #endif // CARGS_ENABLE_STATS
+
+Cargs_Parser CARGS__default_parser = { 0 };
 
     #ifndef CARGS_UNITTEST
 // Will be mocked in the unittests
@@ -225,29 +760,305 @@ void cargs_panic (const char* msg)
 
     #define CARGS__LIST_MARKING_STRING ".."
 
+    #define CARGS__ARL_INITIAL_CAPACITY 10
+
+    // Capacity of the argument registry, when the first argument is added. Capacity is doubled as
+    // it fills up, so it stays a power of 2.
+    #define CARGS__INITIAL_ARG_CAPACITY 16
+
+    // Nodes of the name trie, when the first argument is added. Doubled as it fills up.
+    #define CARGS__INITIAL_TRIE_CAPACITY 64
+
+    // Groups, when the first group is added. Doubled as it fills up.
+    #define CARGS__INITIAL_GROUP_CAPACITY 4
+
+    // Unknown names are suggested a name at most this many edits (insert, delete, replace or swap
+    // of adjacent chars) away. Short names are allowed fewer edits, one for every 3 chars.
+    #define CARGS__MAX_SUGGESTION_DISTANCE 2
+
+    // Offset of the value of a (non static) argument, which is allocated together with it.
+    #define CARGS__ARG_VALUE_OFFSET                                                         \
+        ((sizeof (CARGS__Argument) + _Alignof (max_align_t) - 1) & ~(_Alignof (max_align_t) - 1))
+
+    // SWAR (SIMD within a register) code loads 8 chars in a word and expects the first char in the
+    // lowest byte.
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define CARGS__SWAR_ENABLED
+    #endif // __BYTE_ORDER__
+
+/*******************************************************************************************
+ * Memory functions
+ *********************************************************************************************/
+    #define CARGS__ARENA_ALIGNMENT _Alignof (max_align_t)
+
+static bool CARGS__is_in_arena (const CARGS__Arena* arena, const void* ptr)
+{
+    return arena != NULL && arena->base != NULL && (uintptr_t)ptr >= (uintptr_t)arena->base &&
+           (uintptr_t)ptr < (uintptr_t)arena->base + arena->size;
+}
+
+static void* CARGS__libc_reallocate (Cargs_Allocator* self, void* ptr, size_t old_size,
+                                     size_t new_size)
+{
+    CARGS_UNUSED (self);
+    CARGS_UNUSED (old_size);
+    return realloc (ptr, new_size);
+}
+
+static void CARGS__libc_deallocate (Cargs_Allocator* self, void* ptr, size_t size)
+{
+    CARGS_UNUSED (self);
+    CARGS_UNUSED (size);
+    free (ptr);
+}
+
+static Cargs_Allocator CARGS__libc_allocator = {
+    .reallocate     = CARGS__libc_reallocate,
+    .deallocate     = CARGS__libc_deallocate,
+    .is_thread_safe = true,
+};
+
+static Cargs_Allocator* CARGS__default_allocator = &CARGS__libc_allocator;
+
+static Cargs_Allocator* CARGS__allocator_of (const CARGS__Arena* arena)
+{
+    return (arena != NULL && arena->allocator != NULL) ? arena->allocator
+                                                       : CARGS__default_allocator;
+}
+
+static void* CARGS__heap_alloc (const CARGS__Arena* arena, void* ptr, size_t old_size, size_t size)
+{
+    Cargs_Allocator* allocator = CARGS__allocator_of (arena);
+    return allocator->reallocate (allocator, ptr, old_size, size);
+}
+
+static void CARGS__heap_free (const CARGS__Arena* arena, void* ptr, size_t size)
+{
+    if (ptr != NULL) {
+        Cargs_Allocator* allocator = CARGS__allocator_of (arena);
+        allocator->deallocate (allocator, ptr, size);
+    }
+}
+
+// Allocates from the arena if it is in use, otherwise from the heap. Returns NULL (with errno set)
+// if allocation failed.
+void* CARGS__alloc (CARGS__Arena* arena, size_t size)
+{
+    if (arena == NULL || arena->base == NULL) {
+        return CARGS__heap_alloc (arena, NULL, 0, size);
+    }
+
+    // Address, not the offset, is aligned since the buffer of the arena need not be aligned.
+    uintptr_t address = ((uintptr_t)arena->base + arena->used + CARGS__ARENA_ALIGNMENT - 1) &
+                        ~(uintptr_t)(CARGS__ARENA_ALIGNMENT - 1);
+    size_t offset     = address - (uintptr_t)arena->base;
+    if (offset > arena->size || size > arena->size - offset) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    arena->last_offset = offset;
+    arena->used        = offset + size;
+    return arena->base + offset;
+}
+
+// Returns NULL (with errno set) if allocation failed.
+void* CARGS__realloc (CARGS__Arena* arena, void* ptr, size_t old_size, size_t new_size)
+{
+    if (ptr == NULL) {
+        return CARGS__alloc (arena, new_size);
+    }
+
+    if (!CARGS__is_in_arena (arena, ptr)) {
+        return CARGS__heap_alloc (arena, ptr, old_size, new_size);
+    }
+
+    // Most recent allocation can be grown in place.
+    size_t offset = (uintptr_t)ptr - (uintptr_t)arena->base;
+    if (offset == arena->last_offset && new_size <= arena->size - offset) {
+        arena->used = offset + new_size;
+        return ptr;
+    }
+
+    void* new_ptr = CARGS__alloc (arena, new_size);
+    if (new_ptr != NULL) {
+        memcpy (new_ptr, ptr, CARGS__MIN (old_size, new_size));
+    }
+    return new_ptr;
+}
+
+// size is the size the block was allocated (or last resized) with.
+void CARGS__free (CARGS__Arena* arena, void* ptr, size_t size)
+{
+    // Arena memory is released all at once by cargs_cleanup.
+    if (!CARGS__is_in_arena (arena, ptr)) {
+        CARGS__heap_free (arena, ptr, size);
+    }
+}
+
+void cargs_parser_use_arena (Cargs_Parser* parser, void* buffer, size_t size)
+{
+    CARGS__Arena* arena = &parser->CARGS__arena;
+
+    if (parser->CARGS__arg_count != 0) {
+        cargs_panic ("Arena must be set before adding arguments");
+    }
+
+    if (arena->base != NULL) {
+        cargs_panic ("Arena is already in use");
+    }
+
+    *arena = (CARGS__Arena){
+        .base = buffer, .size = size, .is_owned = false, .allocator = arena->allocator
+    };
+
+    if (buffer == NULL) {
+        if (!(arena->base = CARGS__heap_alloc (arena, NULL, 0, size))) {
+            perror ("[CARGS: ERROR] Allocation failed");
+            cargs_panic (NULL);
+        }
+        arena->is_owned = true;
+    }
+}
+
+void cargs_use_arena (void* buffer, size_t size)
+{
+    cargs_parser_use_arena (&CARGS__default_parser, buffer, size);
+}
+
+// Allocator is kept after cleanup. NULL makes the parser use the default allocator.
+void cargs_parser_use_allocator (Cargs_Parser* parser, Cargs_Allocator* allocator)
+{
+    if (parser->CARGS__arg_count != 0 || parser->CARGS__arena.base != NULL) {
+        cargs_panic ("Allocator must be set before adding arguments or using an arena");
+    }
+    parser->CARGS__arena.allocator = allocator;
+}
+
+void cargs_use_allocator (Cargs_Allocator* allocator)
+{
+    cargs_parser_use_allocator (&CARGS__default_parser, allocator);
+}
+
+void cargs_parser_use_response_files (Cargs_Parser* parser, bool is_on)
+{
+    if (parser->CARGS__is_frozen) {
+        cargs_panic ("Response files cannot be turned on or off in a frozen parser");
+        return;
+    }
+    parser->CARGS__is_response_files_off = !is_on;
+}
+
+void cargs_use_response_files (bool is_on)
+{
+    cargs_parser_use_response_files (&CARGS__default_parser, is_on);
+}
+
+void cargs_set_default_allocator (Cargs_Allocator* allocator)
+{
+    CARGS__default_allocator = (allocator != NULL) ? allocator : &CARGS__libc_allocator;
+}
+
+static void* CARGS__bump_reallocate (Cargs_Allocator* self, void* ptr, size_t old_size,
+                                     size_t new_size)
+{
+    Cargs_BumpAllocator* bump = CARGS_PARENT_OF (self, Cargs_BumpAllocator, allocator);
+    return CARGS__realloc (&bump->CARGS__arena, ptr, old_size, new_size);
+}
+
+static void CARGS__bump_deallocate (Cargs_Allocator* self, void* ptr, size_t size)
+{
+    CARGS_UNUSED (self);
+    CARGS_UNUSED (ptr);
+    CARGS_UNUSED (size);
+}
+
+Cargs_Allocator* cargs_bump_allocator_init (Cargs_BumpAllocator* bump, void* buffer, size_t size)
+{
+    assert (buffer != NULL);
+    *bump = (Cargs_BumpAllocator){
+        .allocator    = { .reallocate     = CARGS__bump_reallocate,
+                          .deallocate     = CARGS__bump_deallocate,
+                          .is_thread_safe = false },
+        .CARGS__arena = { .base = (unsigned char*)buffer, .size = size },
+    };
+    return &bump->allocator;
+}
+
 /*******************************************************************************************
  * ArrayList functions
  *********************************************************************************************/
-Cargs_ArrayList* CARGS__arl_new_with_capacity (size_t capacity, size_t item_size)
+static bool CARGS__arl_is_inline (const Cargs_ArrayList* arl)
+{
+    return arl->buffer == arl->CARGS__inline.CARGS__bytes;
+}
+
+// Initializes an empty list in place, with as many items as fit in its inline buffer (none if an
+// item is larger than the inline buffer, then buffer is allocated on the first push).
+void CARGS__arl_init (Cargs_ArrayList* arl, CARGS__Arena* arena, size_t item_size)
+{
+    arl->item_size    = item_size;
+    arl->len          = 0;
+    arl->CARGS__arena = arena;
+    arl->capacity     = sizeof (arl->CARGS__inline.CARGS__bytes) / item_size;
+    arl->buffer       = (arl->capacity > 0) ? arl->CARGS__inline.CARGS__bytes : NULL;
+}
+
+// Grows the buffer, if needed, so it can hold at least capacity items.
+void CARGS__arl_reserve (Cargs_ArrayList* arl, size_t capacity)
+{
+    if (capacity <= arl->capacity) {
+        return;
+    }
+
+    size_t old_capacity = arl->capacity;
+    bool is_inline      = CARGS__arl_is_inline (arl);
+    arl->capacity       = capacity;
+    if (is_inline) {
+        // Values move out of the inline buffer.
+        if ((arl->buffer = CARGS__alloc (arl->CARGS__arena, arl->item_size * arl->capacity))) {
+            memcpy (arl->buffer, arl->CARGS__inline.CARGS__bytes, arl->item_size * arl->len);
+        }
+    } else {
+        arl->buffer = CARGS__realloc (arl->CARGS__arena, arl->buffer,
+                                      arl->item_size * old_capacity,
+                                      arl->item_size * arl->capacity);
+    }
+    if (arl->buffer == NULL) {
+        perror ("[CARGS: ERROR] Relocation failed");
+        cargs_panic (NULL);
+    }
+}
+
+// Frees the buffer of the list, if it was allocated.
+static void CARGS__arl_free_buffer (Cargs_ArrayList* arl)
+{
+    if (!CARGS__arl_is_inline (arl)) {
+        CARGS__free (arl->CARGS__arena, arl->buffer, arl->item_size * arl->capacity);
+    }
+}
+
+// List (and its buffer, if it does not fit in the list) is allocated in the arena, if it is in use.
+Cargs_ArrayList* CARGS__arl_new_with_capacity (CARGS__Arena* arena, size_t capacity,
+                                               size_t item_size)
 {
     if (capacity == 0) {
         cargs_panic ("Array list must be provided non-zero capacity");
     }
 
-    Cargs_ArrayList* newlist = (Cargs_ArrayList*)malloc (sizeof (Cargs_ArrayList));
+    Cargs_ArrayList* newlist = (Cargs_ArrayList*)CARGS__alloc (arena, sizeof (Cargs_ArrayList));
     if (newlist == NULL) {
         perror ("[CARGS: ERROR] Allocation failed");
         cargs_panic (NULL);
     }
 
-    newlist->capacity  = capacity;
-    newlist->len       = 0;
-    newlist->item_size = item_size;
-    if (newlist->capacity > 0) {
-        if (!(newlist->buffer = malloc (item_size * newlist->capacity))) {
-            perror ("[CARGS: ERROR] Allocation failed");
-            cargs_panic (NULL);
-        }
+    CARGS__arl_init (newlist, arena, item_size);
+    if (capacity <= newlist->capacity) {
+        newlist->capacity = capacity;
+    } else {
+        newlist->capacity = 0;
+        newlist->buffer   = NULL;
+        CARGS__arl_reserve (newlist, capacity);
     }
 
     assert (newlist != NULL);
@@ -257,13 +1068,9 @@ Cargs_ArrayList* CARGS__arl_new_with_capacity (size_t capacity, size_t item_size
 void* CARGS__arl_push (Cargs_ArrayList* arl, void* c)
 {
     if (arl->len >= arl->capacity) {
-        assert (arl->capacity > 0);
-        arl->capacity *= 2;
-        arl->buffer = realloc (arl->buffer, arl->item_size * arl->capacity);
-        if (arl->buffer == NULL) {
-            perror ("[CARGS: ERROR] Relocation failed");
-            cargs_panic (NULL);
-        }
+        // Lists of items which do not fit in the inline buffer start without a buffer.
+        CARGS__arl_reserve (arl, (arl->capacity == 0) ? CARGS__ARL_INITIAL_CAPACITY
+                                                      : arl->capacity * 2);
     }
     void* dest = (void*)((uintptr_t)arl->buffer + (arl->len * arl->item_size));
     if (c != NULL) {
@@ -287,15 +1094,80 @@ void* cargs_arl_pop (Cargs_ArrayList* arl)
 void* CARGS__arl_dealloc (Cargs_ArrayList* arl)
 {
     assert (arl != NULL);
-    free (arl->buffer);
-    free (arl);
+    CARGS__arl_free_buffer (arl);
+    CARGS__free (arl->CARGS__arena, arl, sizeof (Cargs_ArrayList));
     return NULL;
 }
 
+/*******************************************************************************************
+ * Statistics functions
+ *********************************************************************************************/
+    #ifdef CARGS_ENABLE_STATS
+typedef struct {
+    uint64_t start_ns;
+    uint64_t convert_ns; // convert_ns of the parser at the start
+} CARGS__StatsTimer;
+
+static uint64_t CARGS__now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static CARGS__StatsTimer CARGS__stats_start (Cargs_Parser* parser)
+{
+    return (CARGS__StatsTimer){ .start_ns   = CARGS__now_ns(),
+                                .convert_ns = parser->CARGS__stats.convert_ns };
+}
+
+// Time since the timer was started, except the time spent converting values.
+static uint64_t CARGS__stats_elapsed (Cargs_Parser* parser, CARGS__StatsTimer timer)
+{
+    return CARGS__now_ns() - timer.start_ns - (parser->CARGS__stats.convert_ns - timer.convert_ns);
+}
+
+static void CARGS__stats_count_parse (Cargs_Parser* parser, const Cargs_TypeInterface* interface)
+{
+    Cargs_Stats* stats = &parser->CARGS__stats;
+    for (unsigned i = 0; i < stats->type_count; i++) {
+        if (stats->types[i].parse_string == interface->parse_string &&
+            stats->types[i].format_help == interface->format_help) {
+            stats->types[i].parse_count++;
+            return;
+        }
+    }
+    if (stats->type_count < CARGS__ARRAY_LEN (stats->types)) {
+        stats->types[stats->type_count++] = (Cargs_TypeStats){
+            .format_help  = interface->format_help,
+            .parse_string = interface->parse_string,
+            .parse_count  = 1,
+        };
+    }
+}
+    #endif // CARGS_ENABLE_STATS
+
+// Converts input to a value of the type. Conversions of values go through here, so they can be
+// counted and timed.
+static bool CARGS__parse_string (Cargs_Parser* parser, Cargs_TypeInterface* interface,
+                                 const char* input, Cargs_Slice out)
+{
+    #ifdef CARGS_ENABLE_STATS
+    uint64_t start = CARGS__now_ns();
+    bool is_ok     = interface->parse_string (interface, input, out);
+    parser->CARGS__stats.convert_ns += CARGS__now_ns() - start;
+    CARGS__stats_count_parse (parser, interface);
+    return is_ok;
+    #else
+    CARGS_UNUSED (parser);
+    return interface->parse_string (interface, input, out);
+    #endif // CARGS_ENABLE_STATS
+}
+
 /*******************************************************************************************
  * Argument functions
  *********************************************************************************************/
-bool CARGS__assign_value (Cargs_TypeInterface* interface, const char* input)
+bool CARGS__assign_value (Cargs_Parser* parser, Cargs_TypeInterface* interface, const char* input)
 {
     // Special case for flags. Flag arguments must always have a default value, which gets acted on
     // when the flag argument is found during argument parsing.
@@ -306,326 +1178,2252 @@ bool CARGS__assign_value (Cargs_TypeInterface* interface, const char* input)
                                                          interface->type_size));
     } else {
         if (input != NULL) {
-            return interface->parse_string (interface, input,
-                                            CARGS__SLICE_OF (interface->CARGS__value,
-                                                             interface->type_size));
+            return CARGS__parse_string (parser, interface, input,
+                                        CARGS__SLICE_OF (interface->CARGS__value,
+                                                         interface->type_size));
         }
     }
     return true;
 }
 
-CARGS__Argument* CARGS__find_by_name (const char* needle)
+// Converts the pending value of a lazy argument. Result (or failure) is kept till the argument gets
+// another value. Always true for arguments which are not lazy.
+bool CARGS__convert_lazy (Cargs_Parser* parser, CARGS__Argument* arg)
 {
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* arg = CARGS__arg_list[i];
-        if (strncmp (arg->name, needle, CARGS__MAX_NAME_LEN) == 0) {
-            return arg;
+    if (arg->lazy_input != NULL) {
+        const char* input   = arg->lazy_input;
+        arg->lazy_input     = NULL;
+        arg->is_lazy_failed = !CARGS__parse_string (
+            parser, &arg->interface, input,
+            CARGS__SLICE_OF (arg->interface.CARGS__value, arg->interface.type_size));
+        if (arg->is_lazy_failed) {
+            CARGS_ERROR (false, "Invalid '%s' argument value: '%s'", arg->name, input);
         }
     }
-    return NULL;
+    return !arg->is_lazy_failed;
 }
 
-CARGS__Argument* CARGS__find_by_value_address (const void* needle)
+// Records the value of a lazy argument, to be converted on first access.
+bool CARGS__assign_lazy (CARGS__Argument* arg, const char* input)
 {
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* arg = CARGS__arg_list[i];
-        if (arg->interface.CARGS__value == needle) {
-            return arg;
+    arg->lazy_input     = input;
+    arg->is_lazy_failed = false;
+    return input == NULL || arg->interface.check_string == NULL ||
+           arg->interface.check_string (&arg->interface, input);
+}
+
+// FNV-1a hash over the same (clamped) characters which are compared when finding an argument. Name
+// is len chars long, it need not be null terminated.
+uint32_t CARGS__hash_name (const char* name, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns the index table slot which either holds the argument with the given name or is the empty
+// slot where it should be inserted. Name is len (at most CARGS__MAX_NAME_LEN) chars long, it need
+// not be null terminated. Registry must have been allocated (arg_capacity > 0).
+unsigned* CARGS__name_index_slot (Cargs_Parser* parser, const char* name, size_t len)
+{
+    unsigned* name_index = parser->CARGS__name_index;
+    size_t mask          = CARGS__NAME_INDEX_SIZE (parser->CARGS__arg_capacity) - 1;
+
+    size_t slot = CARGS__hash_name (name, len) & mask;
+    while (name_index[slot] != 0) {
+        const char* arg_name = parser->CARGS__args[name_index[slot] - 1]->name;
+        if (strncmp (arg_name, name, len) == 0 &&
+            (len == CARGS__MAX_NAME_LEN || arg_name[len] == '\0')) {
+            break;
         }
+        slot = (slot + 1) & mask;
     }
-    return NULL;
+    return &name_index[slot];
 }
 
-bool CARGS__is_arg_enabled (CARGS__Argument* arg)
+// Finds the argument of a name which is len chars long (the name need not be null terminated).
+CARGS__Argument* CARGS__find_by_span (Cargs_Parser* parser, const char* name, size_t len)
 {
-    if (arg->condition.is_enabled_fn != NULL) {
-        return arg->condition.is_enabled_fn();
+    if (parser->CARGS__arg_capacity == 0) {
+        return NULL;
     }
-    return true;
+    unsigned index = *CARGS__name_index_slot (parser, name, CARGS__MIN (len, CARGS__MAX_NAME_LEN));
+    return (index != 0) ? parser->CARGS__args[index - 1] : NULL;
 }
 
-void* CARGS__cargs_add_arg (const char* name, const char* description,
-                            Cargs_TypeInterface interface, const char* default_value,
-                            bool (*is_enabled_fn) (void), const char* cond_desciption)
+// Names longer than CARGS__MAX_NAME_LEN are cut by CARGS__find_by_span, so the needle is not
+// scanned with that bound (which can be longer than the buffer the needle is in).
+CARGS__Argument* CARGS__find_by_name (Cargs_Parser* parser, const char* needle)
 {
-    CARGS__Argument* new_arg = NULL;
+    return CARGS__find_by_span (parser, needle, strlen (needle));
+}
 
-    if (CARGS__arg_list_count >= CARGS__ARRAY_LEN (CARGS__arg_list)) {
-        cargs_panic ("Too many arguments added");
+// Makes the registry block at args (of capacity arguments) the registry of the parser. Arguments
+// of the parser must already be at the start of the block, they are indexed again.
+static void CARGS__set_registry (Cargs_Parser* parser, CARGS__Argument** args, unsigned capacity)
+{
+    size_t index_size    = CARGS__NAME_INDEX_SIZE (capacity);
+    unsigned* name_index = (unsigned*)(args + capacity);
+    uint64_t* given      = (uint64_t*)(name_index + index_size);
+    memset (name_index, 0, sizeof (unsigned) * index_size);
+    memset (given, 0, sizeof (uint64_t) * CARGS__BITSET_WORDS (capacity));
+
+    parser->CARGS__args         = args;
+    parser->CARGS__name_index   = name_index;
+    parser->CARGS__given        = given;
+    parser->CARGS__arg_capacity = capacity;
+    // Names are unique, so each goes to the first empty slot, without comparing names.
+    size_t mask = index_size - 1;
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        size_t slot = CARGS__hash_name (args[i]->name,
+                                        strnlen (args[i]->name, CARGS__MAX_NAME_LEN)) &
+                      mask;
+        while (name_index[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        name_index[slot] = i + 1;
     }
+}
 
-    if (CARGS__find_by_name (name) != NULL) {
-        cargs_panic ("Duplicate argument with same name exists");
+// Grows the registry, if it is full, so one more argument can be added. Capacity is doubled, so
+// adding n arguments costs O(n) in total, and the name index is rebuilt at its new size. Returns
+// false if allocation failed.
+static bool CARGS__reserve_arg (Cargs_Parser* parser)
+{
+    if (parser->CARGS__arg_count < parser->CARGS__arg_capacity) {
+        return true;
     }
 
-    if (!(new_arg = (CARGS__Argument*)malloc (sizeof (CARGS__Argument)))) {
+    unsigned old_capacity  = parser->CARGS__arg_capacity;
+    unsigned capacity      = (old_capacity == 0) ? CARGS__INITIAL_ARG_CAPACITY : old_capacity * 2;
+    CARGS__Argument** args = (CARGS__Argument**)CARGS__alloc (&parser->CARGS__arena,
+                                                              CARGS__REGISTRY_SIZE (capacity));
+    if (args == NULL) {
         perror ("[CARGS: ERROR] Allocation failed");
         cargs_panic (NULL);
+        return false;
     }
 
-    new_arg->name          = (char*)name;
-    new_arg->description   = (char*)description;
-    new_arg->default_value = (char*)default_value;
-    new_arg->dirty    = false; // Initially args are not dirty. Becomes dirty if was modified later.
-    new_arg->provided = default_value != NULL;
-    new_arg->interface               = interface;
-    new_arg->condition.is_enabled_fn = is_enabled_fn;
-    new_arg->condition.description   = (char*)cond_desciption;
+    if (old_capacity > 0) {
+        memcpy (args, parser->CARGS__args, sizeof (CARGS__Argument*) * parser->CARGS__arg_count);
+        if (!parser->CARGS__is_registry_static) {
+            CARGS__free (&parser->CARGS__arena, parser->CARGS__args,
+                         CARGS__REGISTRY_SIZE (old_capacity));
+        }
+    }
+    parser->CARGS__is_registry_static = false;
+    CARGS__set_registry (parser, args, capacity);
+    return true;
+}
 
-    if (interface.CARGS__allow_multiple) {
-        new_arg->interface.CARGS__value = CARGS__arl_new_with_capacity (10, interface.type_size);
-        if (default_value != NULL) {
-            void* dest = CARGS__arl_push ((Cargs_ArrayList*)new_arg->interface.CARGS__value,
-                                          NULL); // dummy insert
-            assert (dest != NULL);               // push should ensure allocation/relocation worked!
+// Makes room in the trie for count more nodes. Returns false if allocation failed.
+static bool CARGS__trie_reserve (Cargs_Parser* parser, size_t count)
+{
+    size_t capacity = parser->CARGS__trie_capacity;
+    if (parser->CARGS__trie_len + count <= capacity) {
+        return true;
+    }
 
-            new_arg->interface.parse_string (&new_arg->interface, default_value,
-                                             CARGS__SLICE_OF (dest, new_arg->interface.type_size));
+    capacity = (capacity == 0) ? CARGS__INITIAL_TRIE_CAPACITY : capacity;
+    while (capacity < parser->CARGS__trie_len + count) {
+        capacity *= 2;
+    }
+    CARGS__TrieNode* trie = NULL;
+    if (parser->CARGS__is_trie_static) {
+        // Trie in the static storage of a schema is copied out, rather than resized.
+        trie = (CARGS__TrieNode*)CARGS__alloc (&parser->CARGS__arena,
+                                               sizeof (CARGS__TrieNode) * capacity);
+        if (trie != NULL) {
+            memcpy (trie, parser->CARGS__trie, sizeof (CARGS__TrieNode) * parser->CARGS__trie_len);
         }
     } else {
-        if (!(new_arg->interface.CARGS__value = malloc (new_arg->interface.type_size))) {
-            perror ("[CARGS: ERROR] Allocation failed");
-            cargs_panic (NULL);
+        trie = (CARGS__TrieNode*)CARGS__realloc (
+            &parser->CARGS__arena, parser->CARGS__trie,
+            sizeof (CARGS__TrieNode) * parser->CARGS__trie_capacity,
+            sizeof (CARGS__TrieNode) * capacity);
+    }
+    if (trie == NULL) {
+        perror ("[CARGS: ERROR] Allocation failed");
+        cargs_panic (NULL);
+        return false;
+    }
+    parser->CARGS__trie           = trie;
+    parser->CARGS__is_trie_static = false;
+    parser->CARGS__trie_capacity = (unsigned)capacity;
+    return true;
+}
+
+// Adds the name of the argument at index to the trie.
+static bool CARGS__trie_insert (Cargs_Parser* parser, const char* name, unsigned index)
+{
+    size_t len = strnlen (name, CARGS__MAX_NAME_LEN);
+
+    // Room for the whole name (and the root) is made first, so nodes do not move while inserting.
+    if (!CARGS__trie_reserve (parser, len + 1)) {
+        return false;
+    }
+    CARGS__TrieNode* trie = parser->CARGS__trie;
+    if (parser->CARGS__trie_len == 0) {
+        trie[parser->CARGS__trie_len++] = (CARGS__TrieNode){ 0 }; // Root
+    }
+
+    uint32_t node = 0;
+    trie[node].name_count++;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = (unsigned char)name[i];
+        uint32_t* link   = &trie[node].first_child;
+        while (*link != 0 && trie[*link].ch < ch) {
+            link = &trie[*link].next_sibling;
+        }
+        if (*link == 0 || trie[*link].ch != ch) {
+            uint32_t child = parser->CARGS__trie_len++;
+            trie[child]    = (CARGS__TrieNode){ .next_sibling = *link, .ch = ch };
+            *link          = child;
+        }
+        node = *link;
+        trie[node].name_count++;
+    }
+    trie[node].arg = index + 1;
+    return true;
+}
+
+// Returns the node where prefix (len chars long) ends, or NULL if no name starts with it.
+static const CARGS__TrieNode* CARGS__trie_find (const Cargs_Parser* parser, const char* prefix,
+                                                size_t len)
+{
+    const CARGS__TrieNode* trie = parser->CARGS__trie;
+    if (parser->CARGS__trie_len == 0) {
+        return NULL;
+    }
+
+    uint32_t node = 0;
+    for (size_t i = 0; i < CARGS__MIN (len, CARGS__MAX_NAME_LEN); i++) {
+        unsigned char ch = (unsigned char)prefix[i];
+        uint32_t child   = trie[node].first_child;
+        while (child != 0 && trie[child].ch < ch) {
+            child = trie[child].next_sibling;
+        }
+        if (child == 0 || trie[child].ch != ch) {
+            return NULL;
+        }
+        node = child;
+    }
+    return &trie[node];
+}
+
+// Writes to names (at most size of them) the names in the subtree of the node, in sorted order.
+// Returns the new count of names.
+static size_t CARGS__trie_collect (const Cargs_Parser* parser, const CARGS__TrieNode* node,
+                                   const char** names, size_t size, size_t count)
+{
+    if (node->arg != 0 && count < size) {
+        names[count++] = parser->CARGS__args[node->arg - 1]->name;
+    }
+    uint32_t child = node->first_child;
+    while (child != 0 && count < size) {
+        count = CARGS__trie_collect (parser, &parser->CARGS__trie[child], names, size, count);
+        child = parser->CARGS__trie[child].next_sibling;
+    }
+    return count;
+}
+
+// Finds the argument of a name in the command line (len chars long), which is either the full name
+// or a prefix of only one name (an abbreviation). Returns NULL if the name is unknown or is
+// ambiguous.
+CARGS__Argument* CARGS__find_by_token (Cargs_Parser* parser, const char* token, size_t len)
+{
+    CARGS__Argument* arg = CARGS__find_by_span (parser, token, len);
+    if (arg != NULL || len < 2) {
+        return arg; // CARGS__ARGUMENT_PREFIX_CHAR alone is not an abbreviation
+    }
+
+    const CARGS__TrieNode* node = CARGS__trie_find (parser, token, len);
+    if (node == NULL || node->name_count != 1) {
+        return NULL;
+    }
+    // Only one name goes through the node, so it is at the end of its only branch.
+    while (node->arg == 0) {
+        node = &parser->CARGS__trie[node->first_child];
+    }
+    return parser->CARGS__args[node->arg - 1];
+}
+
+typedef struct {
+    const char* token;
+    size_t len;
+    unsigned distance; // Of the best name found so far. Names must be closer than this.
+    uint32_t arg;      // Of the best name found so far, 0 if none
+} CARGS__Suggestion;
+
+// Edit distance (optimal string alignment) of the token and every name in the subtree of the node,
+// a row of the distance table for each node. prev_row is of the node and prev2_row of its parent
+// (NULL if the node is the root). Subtrees whose row has no distance less than the best
+// one found so far are skipped, since distance only grows down the trie.
+static void CARGS__suggest_walk (const Cargs_Parser* parser, uint32_t node,
+                                 const unsigned* prev_row, const unsigned* prev2_row,
+                                 CARGS__Suggestion* suggestion)
+{
+    const CARGS__TrieNode* trie = parser->CARGS__trie;
+    const char* token           = suggestion->token;
+    size_t len                  = suggestion->len;
+    unsigned row[CARGS__MAX_NAME_LEN + 1];
+
+    for (uint32_t child = trie[node].first_child; child != 0; child = trie[child].next_sibling) {
+        unsigned char ch = trie[child].ch;
+        unsigned row_min = row[0] = prev_row[0] + 1;
+        for (size_t j = 1; j <= len; j++) {
+            unsigned cost = (ch == (unsigned char)token[j - 1]) ? 0 : 1;
+            row[j]        = CARGS__MIN (CARGS__MIN (row[j - 1], prev_row[j]) + 1,
+                                        prev_row[j - 1] + cost);
+            if (prev2_row != NULL && j > 1 && ch == (unsigned char)token[j - 2] &&
+                trie[node].ch == (unsigned char)token[j - 1]) {
+                row[j] = CARGS__MIN (row[j], prev2_row[j - 2] + 1); // Adjacent chars swapped
+            }
+            row_min = CARGS__MIN (row_min, row[j]);
+        }
+
+        if (trie[child].arg != 0 && row[len] < suggestion->distance) {
+            suggestion->distance = row[len];
+            suggestion->arg      = trie[child].arg;
+        }
+        if (row_min < suggestion->distance) {
+            CARGS__suggest_walk (parser, child, row, prev_row, suggestion);
+        }
+    }
+}
+
+// Returns the argument whose name is the closest to the unknown name in the command line (len chars
+// long), if it is close enough to be a typo, otherwise NULL.
+CARGS__Argument* CARGS__suggest (Cargs_Parser* parser, const char* token, size_t len)
+{
+    len          = CARGS__MIN (len, CARGS__MAX_NAME_LEN);
+    unsigned max = (unsigned)CARGS__MIN (CARGS__MAX_SUGGESTION_DISTANCE, len / 3);
+    if (parser->CARGS__trie_len == 0 || max == 0) {
+        return NULL;
+    }
+
+    CARGS__Suggestion suggestion = { .token = token, .len = len, .distance = max + 1, .arg = 0 };
+    unsigned row[CARGS__MAX_NAME_LEN + 1];
+    for (size_t j = 0; j <= len; j++) {
+        row[j] = (unsigned)j;
+    }
+    CARGS__suggest_walk (parser, 0, row, NULL, &suggestion);
+    return (suggestion.arg != 0) ? parser->CARGS__args[suggestion.arg - 1] : NULL;
+}
+
+size_t cargs_parser_complete (Cargs_Parser* parser, const char* prefix, const char** names,
+                              size_t size)
+{
+    const CARGS__TrieNode* node = CARGS__trie_find (parser, prefix, strlen (prefix));
+    if (node == NULL) {
+        return 0;
+    }
+    CARGS__trie_collect (parser, node, names, size, 0);
+    return node->name_count;
+}
+
+CARGS__Argument* CARGS__find_by_value_address (Cargs_Parser* parser, const void* needle)
+{
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* arg = parser->CARGS__args[i];
+        if (arg->interface.CARGS__value == needle) {
+            return arg;
+        }
+    }
+    return NULL;
+}
+
+// Multiple values arguments which keep their values in a Cargs_ArrayList
+bool CARGS__is_list (const Cargs_TypeInterface* interface)
+{
+    return interface->CARGS__allow_multiple && interface->CARGS__on_value == NULL;
+}
+
+bool CARGS__is_stream (const Cargs_TypeInterface* interface)
+{
+    return interface->CARGS__allow_multiple && interface->CARGS__on_value != NULL;
+}
+
+    #define CARGS__MAX_DELIMITED_VALUE_LEN CARGS__MAX (CARGS_MAX_INPUT_VALUE_LEN, 512)
+
+// SWAR (8 chars at a time) char search. Chars equal to c become zero bytes in chunk ^ pattern,
+// which are then marked by their high bit (without false positives, unlike the borrow trick).
+static uint64_t CARGS__swar_char_marks (uint64_t chunk, uint64_t pattern)
+{
+    const uint64_t low_bits = 0x7F7F7F7F7F7F7F7Full;
+    chunk ^= pattern;
+    return ~(((chunk & low_bits) + low_bits) | chunk | low_bits);
+}
+
+    // Delimiter sets of up to this many chars are searched 8 chars at a time (one SWAR pattern per
+    // delimiter). Larger sets are searched one char at a time.
+    #define CARGS__MAX_SWAR_DELIMITERS 4
+
+// Fills patterns with the SWAR pattern of every char of delimiters. Returns the number of patterns,
+// 0 if there are more than CARGS__MAX_SWAR_DELIMITERS delimiters.
+static size_t CARGS__swar_patterns (const char* delimiters, uint64_t* patterns)
+{
+    size_t count = strlen (delimiters);
+    if (count > CARGS__MAX_SWAR_DELIMITERS) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        patterns[i] = 0x0101010101010101ull * (unsigned char)delimiters[i];
+    }
+    return count;
+}
+
+// Marks of the chars of chunk which are equal to any of the count patterns.
+static uint64_t CARGS__swar_set_marks (uint64_t chunk, const uint64_t* patterns, size_t count)
+{
+    uint64_t marks = 0;
+    for (size_t i = 0; i < count; i++) {
+        marks |= CARGS__swar_char_marks (chunk, patterns[i]);
+    }
+    return marks;
+}
+
+// Number of chars in the len chars of input which are any of the delimiters.
+static size_t CARGS__count_delimiters (const char* input, size_t len, const char* delimiters)
+{
+    uint64_t patterns[CARGS__MAX_SWAR_DELIMITERS];
+    size_t pattern_count = CARGS__swar_patterns (delimiters, patterns);
+
+    size_t count = 0;
+    size_t i     = 0;
+    for (; pattern_count > 0 && len - i >= 8; i += 8) {
+        uint64_t chunk;
+        memcpy (&chunk, input + i, sizeof (chunk));
+        count += (size_t)__builtin_popcountll (CARGS__swar_set_marks (chunk, patterns,
+                                                                      pattern_count));
+    }
+    for (; i < len; i++) {
+        count += (strchr (delimiters, input[i]) != NULL);
+    }
+    return count;
+}
+
+// Offset of the first delimiter in the len chars of input, len if there is none. patterns are of
+// the delimiters (see CARGS__swar_patterns), is_delimiter is used if there are none.
+static size_t CARGS__find_delimiter (const char* input, size_t len, const uint64_t* patterns,
+                                     size_t pattern_count, const bool* is_delimiter)
+{
+    size_t i = 0;
+    #ifdef CARGS__SWAR_ENABLED // First char is in the lowest byte only on little endian
+    for (; pattern_count > 0 && len - i >= 8; i += 8) {
+        uint64_t chunk;
+        memcpy (&chunk, input + i, sizeof (chunk));
+        uint64_t marks = CARGS__swar_set_marks (chunk, patterns, pattern_count);
+        if (marks != 0) {
+            return i + (size_t)__builtin_ctzll (marks) / 8;
+        }
+    }
+    #else
+    CARGS_UNUSED (patterns);
+    CARGS_UNUSED (pattern_count);
+    #endif // CARGS__SWAR_ENABLED
+    for (; i < len && !is_delimiter[(unsigned char)input[i]]; i++) {
+    }
+    return i;
+}
+
+// Number of values in the input of a delimited list argument.
+static size_t CARGS__count_delimited_values (const char* input, size_t input_len,
+                                             const char* delimiters)
+{
+    return 1 + CARGS__count_delimiters (input, input_len, delimiters);
+}
+
+// Parses input and adds the value(s) to the list of a list argument. For delimited lists, buffer is
+// grown only once for all the values in input, which are then parsed right into the buffer.
+bool CARGS__parse_list_values (Cargs_Parser* parser, Cargs_TypeInterface* interface,
+                               const char* input)
+{
+    Cargs_ArrayList* list  = (Cargs_ArrayList*)interface->CARGS__value;
+    const char* delimiters = interface->CARGS__delimiters;
+    CARGS__STATS (size_t old_capacity = list->capacity);
+
+    if (delimiters == NULL) {
+        void* dest = CARGS__arl_push (list, NULL); // dummy insert
+        assert (dest != NULL); // push should ensure allocation/relocation worked!
+        CARGS__STATS (parser->CARGS__stats.list_growth_count += list->capacity != old_capacity);
+        return CARGS__parse_string (parser, interface, input,
+                                    CARGS__SLICE_OF (dest, interface->type_size));
+    }
+
+    bool is_delimiter[UCHAR_MAX + 1] = { false };
+    for (const char* d = delimiters; *d != '\0'; d++) {
+        is_delimiter[(unsigned char)*d] = true;
+    }
+
+    uint64_t patterns[CARGS__MAX_SWAR_DELIMITERS];
+    size_t pattern_count = CARGS__swar_patterns (delimiters, patterns);
+
+    size_t input_len   = strlen (input);
+    size_t value_count = CARGS__count_delimited_values (input, input_len, delimiters);
+    // Geometric growth, so giving many delimited values one token at a time is not quadratic.
+    if (list->len + value_count > list->capacity) {
+        CARGS__arl_reserve (list, CARGS__MAX (list->len + value_count, list->capacity * 2));
+        CARGS__STATS (parser->CARGS__stats.list_growth_count++);
+    }
+
+    // Values are copied, since parse_string takes a null terminated string.
+    char value[CARGS__MAX_DELIMITED_VALUE_LEN + 1];
+    const char* end = input + input_len;
+    for (const char* cur = input; cur <= end;) {
+        size_t value_len = CARGS__find_delimiter (cur, (size_t)(end - cur), patterns,
+                                                  pattern_count, is_delimiter);
+        if (value_len > CARGS__MAX_DELIMITED_VALUE_LEN) {
+            return false;
+        }
+        memcpy (value, cur, value_len);
+        value[value_len] = '\0';
+        cur += value_len + 1;
+
+        void* dest = (void*)((uintptr_t)list->buffer + (list->len++ * list->item_size));
+        if (!CARGS__parse_string (parser, interface, value,
+                                  CARGS__SLICE_OF (dest, interface->type_size))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CARGS__is_conditional (const CARGS__Argument* arg)
+{
+    return arg->condition.is_enabled_fn != NULL || arg->condition.when_name != NULL;
+}
+
+bool CARGS__values_equal (Cargs_TypeInterface* interface, const void* a, const void* b)
+{
+    return (interface->equals != NULL) ? interface->equals (interface, a, b)
+                                       : memcmp (a, b, interface->type_size) == 0;
+}
+
+// Finds the argument the condition is on and parses the value it is compared with. This is done on
+// the first evaluation, so an argument can be added after the ones whose conditions are on it.
+CARGS__Argument* CARGS__resolve_condition (Cargs_Parser* parser, CARGS__Argument* arg)
+{
+    if (arg->condition.when_arg != NULL) {
+        return arg->condition.when_arg;
+    }
+
+    CARGS__Argument* when_arg = CARGS__find_by_name (parser, arg->condition.when_name);
+    if (when_arg == NULL) {
+        cargs_panic ("Condition is on an unknown argument");
+        return NULL;
+    }
+    if (when_arg->interface.CARGS__allow_multiple) {
+        cargs_panic ("Condition cannot be on an argument with multiple values");
+        return NULL;
+    }
+
+    Cargs_TypeInterface interface = when_arg->interface;
+    if (!(interface.CARGS__value = CARGS__alloc (&parser->CARGS__arena, interface.type_size))) {
+        perror ("[CARGS: ERROR] Allocation failed");
+        cargs_panic (NULL);
+        return NULL;
+    }
+    memset (interface.CARGS__value, 0, interface.type_size);
+
+    // Value of a flag is the given boolean, not the one which flips its default value.
+    Cargs_Slice out = CARGS__SLICE_OF (interface.CARGS__value, interface.type_size);
+    if (!(interface.CARGS__is_flag
+              ? cargs_bool_parse_string (&interface, arg->condition.when_value, out)
+              : CARGS__parse_string (parser, &interface, arg->condition.when_value, out))) {
+        cargs_panic ("Invalid condition value");
+    }
+
+    arg->condition.when_parsed_value = interface.CARGS__value;
+    return arg->condition.when_arg   = when_arg;
+}
+
+// Conditions form chains (when_name of an argument can have its own condition and so on), which are
+// walked depth first. Result of each argument is kept till the next parsing, so every condition
+// (including is_enabled_fn) is evaluated once, after all of the ones it depends on.
+bool CARGS__is_arg_enabled (Cargs_Parser* parser, CARGS__Argument* arg)
+{
+    if (arg->condition.state != CARGS__CONDITION_UNKNOWN) {
+        return arg->condition.state == CARGS__CONDITION_ENABLED;
+    }
+
+    bool is_enabled = true;
+    if (arg->condition.is_enabled_fn != NULL) {
+        is_enabled = arg->condition.is_enabled_fn();
+        CARGS__STATS (parser->CARGS__stats.is_enabled_fn_count++);
+    } else if (arg->condition.when_name != NULL) {
+        CARGS__Argument* when_arg = CARGS__resolve_condition (parser, arg);
+        is_enabled = when_arg != NULL && CARGS__is_arg_enabled (parser, when_arg) &&
+                     CARGS__convert_lazy (parser, when_arg) &&
+                     CARGS__values_equal (&when_arg->interface, when_arg->interface.CARGS__value,
+                                          arg->condition.when_parsed_value);
+    }
+
+    arg->condition.state = is_enabled ? CARGS__CONDITION_ENABLED : CARGS__CONDITION_DISABLED;
+    return is_enabled;
+}
+
+// Results of the conditions are no longer valid once the values change.
+void CARGS__reset_conditions (Cargs_Parser* parser)
+{
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        parser->CARGS__args[i]->condition.state = CARGS__CONDITION_UNKNOWN;
+    }
+}
+
+void CARGS__check_new_arg (Cargs_Parser* parser, const char* name)
+{
+    if (parser->CARGS__is_frozen) {
+        cargs_panic ("Arguments cannot be added to a frozen parser");
+    }
+
+    if (CARGS__find_by_name (parser, name) != NULL) {
+        cargs_panic ("Duplicate argument with same name exists");
+    }
+}
+
+void CARGS__register_arg (Cargs_Parser* parser, CARGS__Argument* arg)
+{
+    if (!CARGS__reserve_arg (parser) ||
+        !CARGS__trie_insert (parser, arg->name, parser->CARGS__arg_count)) {
+        return;
+    }
+    unsigned* index_slot = CARGS__name_index_slot (parser, arg->name,
+                                                   strnlen (arg->name, CARGS__MAX_NAME_LEN));
+
+    arg->index                                      = parser->CARGS__arg_count;
+    parser->CARGS__args[parser->CARGS__arg_count++] = arg;
+    *index_slot                                     = parser->CARGS__arg_count;
+    parser->CARGS__list_count += CARGS__is_list (&arg->interface);
+
+    // Help message layout is kept up to date, so printing it needs no measuring.
+    arg->format_help_len = strlen (arg->interface.format_help) +
+                           (arg->interface.CARGS__allow_multiple
+                                ? sizeof (CARGS__LIST_MARKING_STRING) - 1
+                                : 0);
+    parser->CARGS__help_name_width   = CARGS__MAX (parser->CARGS__help_name_width,
+                                                   strlen (arg->name));
+    parser->CARGS__help_format_width = CARGS__MAX (parser->CARGS__help_format_width,
+                                                   arg->format_help_len);
+}
+
+void CARGS__add_static_args (Cargs_Parser* parser, const Cargs_StaticArg* args, size_t count,
+                             CARGS__StaticSchema* schema, void* values)
+{
+    if (schema->is_in_use) {
+        cargs_panic ("Static schema is already added to a parser");
+        return;
+    }
+    // Interface would write a value of its size into the field of the C type.
+    for (size_t i = 0; i < count; i++) {
+        if (!args[i].is_list && args[i].type_size != args[i].interface->type_size) {
+            cargs_panic ("Static argument type does not match the size of its interface");
+            return;
+        }
+    }
+    CARGS__STATS (CARGS__StatsTimer timer = CARGS__stats_start (parser));
+
+    // Values of an earlier use of the schema are put back to the defaults.
+    memcpy (values, schema->initial_values, schema->values_size);
+    schema->is_in_use = true;
+
+    // Parser without arguments takes the registry and the trie of the schema, with the capacity
+    // (a power of 2) for all of its arguments, so registering them allocates nothing.
+    if (parser->CARGS__arg_capacity == 0 && parser->CARGS__trie_capacity == 0) {
+        unsigned capacity = 1;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        CARGS__set_registry (parser, (CARGS__Argument**)schema->registry, capacity);
+        parser->CARGS__is_registry_static = true;
+        parser->CARGS__trie               = schema->trie;
+        parser->CARGS__trie_capacity      = schema->trie_capacity;
+        parser->CARGS__is_trie_static     = true;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const Cargs_StaticArg* sarg = &args[i];
+        CARGS__Argument* new_arg    = &schema->args[i];
+
+        CARGS__check_new_arg (parser, sarg->name);
+
+        new_arg->name                    = (char*)sarg->name;
+        new_arg->description             = (char*)sarg->description;
+        new_arg->default_value           = (char*)sarg->default_value;
+        new_arg->dirty                   = false;
+        new_arg->provided                = sarg->default_value != NULL;
+        new_arg->static_schema           = schema;
+        new_arg->lazy_input              = NULL;
+        new_arg->is_lazy_failed          = false;
+        new_arg->interface               = *sarg->interface;
+        memset (&new_arg->condition, 0, sizeof (new_arg->condition));
+
+        // Value (and its default) is already in the schema values struct.
+        new_arg->interface.CARGS__value = (void*)((uintptr_t)values + sarg->value_offset);
+
+        if (sarg->is_list) {
+            assert (!new_arg->interface.CARGS__is_flag);
+            new_arg->interface.CARGS__allow_multiple = true;
+
+            CARGS__arl_init ((Cargs_ArrayList*)new_arg->interface.CARGS__value,
+                             &parser->CARGS__arena, new_arg->interface.type_size);
         }
 
-        if (!CARGS__assign_value (&new_arg->interface, default_value)) {
+        CARGS__register_arg (parser, new_arg);
+    }
+    CARGS__STATS (parser->CARGS__stats.register_ns += CARGS__stats_elapsed (parser, timer));
+}
+
+// Size of a (non static) argument together with its value.
+static size_t CARGS__arg_alloc_size (const Cargs_TypeInterface* interface)
+{
+    return CARGS__ARG_VALUE_OFFSET +
+           (CARGS__is_list (interface) ? sizeof (Cargs_ArrayList) : interface->type_size);
+}
+
+void* CARGS__parser_add_arg (Cargs_Parser* parser, const char* name, const char* description,
+                             Cargs_TypeInterface interface, const char* default_value,
+                             bool (*is_enabled_fn) (void), const char* cond_desciption)
+{
+    CARGS__Argument* new_arg = NULL;
+    CARGS__Arena* arena      = &parser->CARGS__arena;
+    CARGS__STATS (CARGS__StatsTimer timer = CARGS__stats_start (parser));
+
+    CARGS__check_new_arg (parser, name);
+
+    // Value is kept right after the argument, so adding an argument is a single allocation.
+    if (!(new_arg = (CARGS__Argument*)CARGS__alloc (arena, CARGS__arg_alloc_size (&interface)))) {
+        perror ("[CARGS: ERROR] Allocation failed");
+        cargs_panic (NULL);
+    }
+
+    new_arg->name          = (char*)name;
+    new_arg->description   = (char*)description;
+    new_arg->default_value = (char*)default_value;
+    new_arg->dirty    = false; // Initially args are not dirty. Becomes dirty if was modified later.
+    new_arg->provided = default_value != NULL;
+    new_arg->static_schema  = NULL;
+    new_arg->lazy_input     = NULL;
+    new_arg->is_lazy_failed = false;
+    new_arg->interface = interface;
+    memset (&new_arg->condition, 0, sizeof (new_arg->condition));
+    new_arg->condition.is_enabled_fn = is_enabled_fn;
+    new_arg->condition.description   = (char*)cond_desciption;
+
+    new_arg->interface.CARGS__value = (void*)((uintptr_t)new_arg + CARGS__ARG_VALUE_OFFSET);
+    if (CARGS__is_list (&interface)) {
+        CARGS__arl_init ((Cargs_ArrayList*)new_arg->interface.CARGS__value, arena,
+                         interface.type_size);
+        if (default_value != NULL &&
+            !CARGS__parse_list_values (parser, &new_arg->interface, default_value)) {
+            cargs_panic ("Invalid default value");
+        }
+    } else {
+        // Zero initialized, so values can be compared byte by byte (see CARGS__values_equal)
+        memset (new_arg->interface.CARGS__value, 0, new_arg->interface.type_size);
+
+        // For streams, the default value is kept parsed and is passed on after parsing.
+        bool is_valid = interface.CARGS__is_lazy
+                            ? CARGS__assign_lazy (new_arg, default_value)
+                            : CARGS__assign_value (parser, &new_arg->interface, default_value);
+        if (!is_valid) {
             cargs_panic ("Invalid default value");
         }
     }
 
-    CARGS__arg_list[CARGS__arg_list_count++] = new_arg;
+    CARGS__register_arg (parser, new_arg);
+    CARGS__STATS (parser->CARGS__stats.register_ns += CARGS__stats_elapsed (parser, timer));
 
     assert (new_arg != NULL); // Cannot be null since all previous errors must have been handled.
     return new_arg->interface.CARGS__value;
 }
 
-void cargs_cleanup()
+void* CARGS__cargs_add_arg (const char* name, const char* description,
+                            Cargs_TypeInterface interface, const char* default_value,
+                            bool (*is_enabled_fn) (void), const char* cond_desciption)
 {
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* arg = CARGS__arg_list[i];
-        if (arg->interface.CARGS__value != NULL) {
-            if (arg->interface.CARGS__allow_multiple) {
-                CARGS__arl_dealloc ((Cargs_ArrayList*)arg->interface.CARGS__value);
-            } else {
-                free (arg->interface.CARGS__value);
+    return CARGS__parser_add_arg (&CARGS__default_parser, name, description, interface,
+                                  default_value, is_enabled_fn, cond_desciption);
+}
+
+void* CARGS__parser_add_when_arg (Cargs_Parser* parser, const char* when_name,
+                                  const char* when_value, const char* name,
+                                  const char* description, Cargs_TypeInterface interface,
+                                  const char* default_value)
+{
+    // Each argument depends on at most one other, so a cycle is found by following the chain of
+    // (already added) arguments, starting from the one this argument would depend on.
+    for (const char* chain_name = when_name; chain_name != NULL;) {
+        if (strncmp (chain_name, name, CARGS__MAX_NAME_LEN) == 0) {
+            cargs_panic ("Argument conditions must not form a cycle");
+            break;
+        }
+        CARGS__Argument* chain_arg = CARGS__find_by_name (parser, chain_name);
+        chain_name                 = (chain_arg != NULL) ? chain_arg->condition.when_name : NULL;
+    }
+
+    void* value = CARGS__parser_add_arg (parser, name, description, interface, default_value, NULL,
+                                         NULL);
+
+    CARGS__Argument* new_arg     = parser->CARGS__args[parser->CARGS__arg_count - 1];
+    new_arg->condition.when_name  = when_name;
+    new_arg->condition.when_value = when_value;
+    return value;
+}
+
+    #define CARGS__BITSET_SET(bitset, bit) ((bitset)[(bit) / 64] |= (1ull << ((bit) % 64)))
+    #define CARGS__BITSET_HAS(bitset, bit) (((bitset)[(bit) / 64] >> ((bit) % 64)) & 1)
+
+// Returns the next group of the parser, with no members, which has a bit for each of the arguments
+// added so far. It is counted in the parser, once its members are set. Groups are grown (doubled)
+// as they fill up. Returns NULL if allocation failed.
+static CARGS__Group* CARGS__new_group (Cargs_Parser* parser, Cargs_GroupKind kind)
+{
+    if (parser->CARGS__group_count == parser->CARGS__group_capacity) {
+        size_t old_size      = sizeof (CARGS__Group) * parser->CARGS__group_capacity;
+        unsigned capacity    = (parser->CARGS__group_capacity == 0)
+                                   ? CARGS__INITIAL_GROUP_CAPACITY
+                                   : parser->CARGS__group_capacity * 2;
+        CARGS__Group* groups = (CARGS__Group*)CARGS__realloc (&parser->CARGS__arena,
+                                                              parser->CARGS__groups, old_size,
+                                                              sizeof (CARGS__Group) * capacity);
+        if (groups == NULL) {
+            perror ("[CARGS: ERROR] Allocation failed");
+            cargs_panic (NULL);
+            return NULL;
+        }
+        parser->CARGS__groups         = groups;
+        parser->CARGS__group_capacity = capacity;
+    }
+
+    CARGS__Group* group = &parser->CARGS__groups[parser->CARGS__group_count];
+    group->kind         = kind;
+    group->word_count   = CARGS__BITSET_WORDS (parser->CARGS__arg_count);
+    group->members      = NULL;
+    if (group->word_count == 0) {
+        return group; // Group without any arguments
+    }
+
+    group->members = (uint64_t*)CARGS__alloc (&parser->CARGS__arena,
+                                              sizeof (uint64_t) * group->word_count);
+    if (group->members == NULL) {
+        perror ("[CARGS: ERROR] Allocation failed");
+        cargs_panic (NULL);
+        return NULL;
+    }
+    memset (group->members, 0, sizeof (uint64_t) * group->word_count);
+    return group;
+}
+
+void CARGS__parser_add_group (Cargs_Parser* parser, Cargs_GroupKind kind,
+                              const char* const* names, size_t count)
+{
+    if (parser->CARGS__is_frozen) {
+        cargs_panic ("Groups cannot be added to a frozen parser");
+        return;
+    }
+
+    CARGS__Group* group = CARGS__new_group (parser, kind);
+    if (group == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        char name[CARGS__MAX_NAME_LEN + 1];
+        snprintf (name, sizeof (name), CARGS__ARGUMENT_PREFIX_CHAR "%s", names[i]);
+
+        CARGS__Argument* arg = CARGS__find_by_name (parser, name);
+        if (arg == NULL) {
+            cargs_panic ("Group has an unknown argument");
+            return;
+        }
+        CARGS__BITSET_SET (group->members, arg->index);
+    }
+    parser->CARGS__group_count++;
+}
+
+// Writes the names of the group members, separated by ', ', to buffer. Names which do not fit are
+// left out.
+static const char* CARGS__group_names (Cargs_Parser* parser, const CARGS__Group* group,
+                                       char* buffer, size_t size)
+{
+    size_t len = 0;
+    buffer[0]  = '\0';
+    for (unsigned i = 0; i < group->word_count * 64 && i < parser->CARGS__arg_count; i++) {
+        if (CARGS__BITSET_HAS (group->members, i)) {
+            int written = snprintf (buffer + len, size - len, "%s%s", (len > 0) ? ", " : "",
+                                    parser->CARGS__args[i]->name);
+            if (written < 0 || (size_t)written >= size - len) {
+                buffer[len] = '\0';
+                break;
             }
+            len += (size_t)written;
+        }
+    }
+    return buffer;
+}
+
+// Checks all the groups, with a single pass over the groups. Number of given arguments in a group
+// is the popcount of the group members and the arguments given in the command line.
+bool CARGS__check_groups (Cargs_Parser* parser)
+{
+    for (unsigned g = 0; g < parser->CARGS__group_count; g++) {
+        const CARGS__Group* group = &parser->CARGS__groups[g];
+        unsigned member_count     = 0;
+        unsigned given_count      = 0;
+
+        for (unsigned w = 0; w < group->word_count; w++) {
+            member_count += (unsigned)__builtin_popcountll (group->members[w]);
+            given_count += (unsigned)__builtin_popcountll (group->members[w] &
+                                                           parser->CARGS__given[w]);
         }
-        free (arg);
+
+        char names[256];
+        if (group->kind == CARGS_GROUP_MUTEX && given_count > 1) {
+            CARGS_ERROR (false, "Only one of the arguments %s can be given",
+                         CARGS__group_names (parser, group, names, sizeof (names)));
+        } else if (group->kind == CARGS_GROUP_TOGETHER && given_count != 0 &&
+                   given_count != member_count) {
+            CARGS_ERROR (false, "Arguments %s must be given together",
+                         CARGS__group_names (parser, group, names, sizeof (names)));
+        } else if (group->kind == CARGS_GROUP_AT_LEAST_ONE && given_count == 0) {
+            CARGS_ERROR (false, "At least one of the arguments %s is required",
+                         CARGS__group_names (parser, group, names, sizeof (names)));
+        }
+    }
+    return true;
+}
+
+// Unmaps the response files parsed so far. Values pointing into them become invalid.
+static void CARGS__unmap_response_files (Cargs_Parser* parser)
+{
+    #ifdef CARGS__RESPONSE_FILES_ENABLED
+    Cargs_ArrayList* response_files = parser->CARGS__response_files;
+    if (response_files != NULL) {
+        for (Cargs_Slice* mapping = (Cargs_Slice*)cargs_arl_pop (response_files); mapping != NULL;
+             mapping              = (Cargs_Slice*)cargs_arl_pop (response_files)) {
+            munmap (mapping->address, mapping->len);
+        }
+    }
+    #else
+    CARGS_UNUSED (parser);
+    #endif // CARGS__RESPONSE_FILES_ENABLED
+}
+
+void cargs_parser_cleanup (Cargs_Parser* parser)
+{
+    CARGS__Arena* arena = &parser->CARGS__arena;
+    bool is_arena_used  = arena->base != NULL;
+
+    // Values of the conditions are freed first, since their size is the size of the value of
+    // their when_arg, which can be any other argument.
+    for (unsigned i = 0; !is_arena_used && i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* arg = parser->CARGS__args[i];
+        if (arg->condition.when_parsed_value != NULL) {
+            CARGS__free (arena, arg->condition.when_parsed_value,
+                         arg->condition.when_arg->interface.type_size);
+        }
+    }
+
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* arg = parser->CARGS__args[i];
+        if (arg->static_schema != NULL) {
+            arg->static_schema->is_in_use = false;
+            // Only the buffer of a static list is allocated, the rest is in static storage.
+            if (arg->interface.CARGS__allow_multiple) {
+                Cargs_ArrayList* list = (Cargs_ArrayList*)arg->interface.CARGS__value;
+                CARGS__arl_free_buffer (list);
+                *list = (Cargs_ArrayList){ 0 };
+            }
+            continue;
+        }
+        if (is_arena_used) {
+            continue; // Released all at once below
+        }
+        if (CARGS__is_list (&arg->interface)) {
+            CARGS__arl_free_buffer ((Cargs_ArrayList*)arg->interface.CARGS__value);
+        }
+        CARGS__free (arena, arg, CARGS__arg_alloc_size (&arg->interface)); // Value is in it
+    }
+    for (unsigned g = 0; !is_arena_used && g < parser->CARGS__group_count; g++) {
+        const CARGS__Group* group = &parser->CARGS__groups[g];
+        CARGS__free (arena, group->members, sizeof (uint64_t) * group->word_count);
+    }
+    if (!is_arena_used) {
+        CARGS__free (arena, parser->CARGS__groups,
+                     sizeof (CARGS__Group) * parser->CARGS__group_capacity);
+    }
+    if (!is_arena_used && parser->CARGS__args != NULL && !parser->CARGS__is_registry_static) {
+        CARGS__free (arena, parser->CARGS__args,
+                     CARGS__REGISTRY_SIZE (parser->CARGS__arg_capacity));
+    }
+    if (!is_arena_used && parser->CARGS__trie != NULL && !parser->CARGS__is_trie_static) {
+        CARGS__free (arena, parser->CARGS__trie,
+                     sizeof (CARGS__TrieNode) * parser->CARGS__trie_capacity);
+    }
+
+    parser->CARGS__arg_count             = 0;
+    parser->CARGS__arg_capacity          = 0;
+    parser->CARGS__list_count            = 0;
+    parser->CARGS__args                  = NULL;
+    parser->CARGS__name_index            = NULL;
+    parser->CARGS__given                 = NULL;
+    parser->CARGS__trie                  = NULL;
+    parser->CARGS__trie_len              = 0;
+    parser->CARGS__trie_capacity         = 0;
+    parser->CARGS__is_registry_static    = false;
+    parser->CARGS__is_trie_static        = false;
+    parser->CARGS__group_count           = 0;
+    parser->CARGS__group_capacity        = 0;
+    parser->CARGS__groups                = NULL;
+    parser->CARGS__is_frozen             = false;
+    parser->CARGS__help_name_width       = 0;
+    parser->CARGS__help_format_width     = 0;
+    parser->CARGS__is_response_files_off = false;
+    CARGS__STATS (memset (&parser->CARGS__stats, 0, sizeof (parser->CARGS__stats)));
+
+    CARGS__unmap_response_files (parser);
+    if (parser->CARGS__response_files != NULL) {
+        parser->CARGS__response_files = CARGS__arl_dealloc (parser->CARGS__response_files);
+    }
+
+    if (is_arena_used) {
+        if (arena->is_owned) {
+            CARGS__heap_free (arena, arena->base, arena->size);
+        }
+        *arena = (CARGS__Arena){ .allocator = arena->allocator };
+    }
+}
+
+void cargs_cleanup()
+{
+    cargs_parser_cleanup (&CARGS__default_parser);
+}
+
+// After freezing, no argument can be added and the parser can only be used as the schema for
+// cargs_parse_batch. cargs_parser_cleanup releases the parser as usual.
+void cargs_parser_freeze (Cargs_Parser* parser)
+{
+    parser->CARGS__is_frozen = true;
+}
+
+void* CARGS__parser_get (Cargs_Parser* parser, const char* name)
+{
+    CARGS__Argument* arg = CARGS__find_by_name (parser, name);
+    return (arg != NULL && CARGS__convert_lazy (parser, arg)) ? arg->interface.CARGS__value : NULL;
+}
+
+bool CARGS__parser_is_enabled (Cargs_Parser* parser, const char* name)
+{
+    CARGS__Argument* arg = CARGS__find_by_name (parser, name);
+    return arg != NULL && CARGS__is_arg_enabled (parser, arg);
+}
+
+    #ifdef CARGS_ENABLE_STATS
+Cargs_Stats cargs_parser_get_stats (Cargs_Parser* parser)
+{
+    Cargs_Stats stats = parser->CARGS__stats;
+
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        const CARGS__Argument* arg = parser->CARGS__args[i];
+        if (CARGS__is_list (&arg->interface)) {
+            const Cargs_ArrayList* list = (const Cargs_ArrayList*)arg->interface.CARGS__value;
+            stats.value_bytes += sizeof (Cargs_ArrayList) +
+                                 (CARGS__arl_is_inline (list) ? 0
+                                                              : list->capacity * list->item_size);
+        } else {
+            stats.value_bytes += arg->interface.type_size;
+        }
+        if (arg->condition.when_parsed_value != NULL) {
+            stats.value_bytes += arg->condition.when_arg->interface.type_size;
+        }
+    }
+    return stats;
+}
+
+Cargs_Stats cargs_get_stats (void)
+{
+    return cargs_parser_get_stats (&CARGS__default_parser);
+}
+    #endif // CARGS_ENABLE_STATS
+
+typedef enum {
+    CARGS__TOKEN_VALUE,   // Value of the current argument
+    CARGS__TOKEN_NAME,    // Name of an argument, with a value if it was given as name=value
+    CARGS__TOKEN_BUNDLE,  // One char names of flags, given together (-abc is -a -b -c)
+    CARGS__TOKEN_UNKNOWN, // Name which is not of any argument
+} CARGS__TokenKind;
+
+// Command line token, split in place: name and value point into the token.
+typedef struct {
+    CARGS__TokenKind kind;
+    CARGS__Argument* arg; // Argument of a name
+    const char* name;     // Name, without the extra prefix char of the long form (--name)
+    size_t name_len;
+    const char* value; // Value after '=' of a name, the token itself for a value, otherwise NULL
+} CARGS__Token;
+
+// A value which starts with CARGS__ARGUMENT_PREFIX_CHAR (and is not a name) is either a negative
+// number (of any type which takes numbers) or is accepted by check_string of the type, if it has
+// one. So a custom type needs check_string for its other prefixed values to be values, in lists
+// too (for a delimited list it is given the whole token). Whether the value is valid is found when
+// it is converted, as for any other value.
+static bool CARGS__is_prefixed_value (CARGS__Argument* arg, const char* token)
+{
+    if (arg->interface.CARGS__is_flag) {
+        return false;
+    }
+    char c = token[1];
+    return (c >= '0' && c <= '9') || (c == '.' && token[2] >= '0' && token[2] <= '9') ||
+           (arg->interface.check_string != NULL &&
+            arg->interface.check_string (&arg->interface, token));
+}
+
+// true if every char of the name (after CARGS__ARGUMENT_PREFIX_CHAR) is the name of an argument,
+// all of which are flags, except the last one which can take a value.
+static bool CARGS__is_bundle (Cargs_Parser* parser, const char* name, size_t len)
+{
+    if (len < 3) {
+        return false;
+    }
+    for (size_t i = 1; i < len; i++) {
+        const char short_name[] = { CARGS__ARGUMENT_PREFIX_CHAR[0], name[i] };
+        const CARGS__Argument* arg = CARGS__find_by_span (parser, short_name, 2);
+        if (arg == NULL || (i + 1 < len && !arg->interface.CARGS__is_flag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// true if the token is a value of arg, found without splitting it: it either does not start with
+// CARGS__ARGUMENT_PREFIX_CHAR, or it is a prefixed value (such as a negative number) and no name
+// starts with its first two chars, so it is neither a name nor a bundle.
+static bool CARGS__is_plain_value (Cargs_Parser* parser, CARGS__Argument* arg, const char* token)
+{
+    return token[0] != CARGS__ARGUMENT_PREFIX_CHAR[0] ||
+           (CARGS__is_prefixed_value (arg, token) && CARGS__trie_find (parser, token, 2) == NULL);
+}
+
+// Finds what a command line token is, in a single pass over it (for the '=') and without copying
+// it. A token starting with CARGS__ARGUMENT_PREFIX_CHAR is a name (-name, --name, -name=value or
+// --name=value), then a bundle of flags and, if it is neither, can still be a value of the current
+// argument (see CARGS__is_prefixed_value).
+static CARGS__Token CARGS__split_token (Cargs_Parser* parser, const char* token,
+                                        CARGS__Argument* current_arg)
+{
+    CARGS__Token split = { .kind = CARGS__TOKEN_VALUE, .value = token };
+    if (token[0] != CARGS__ARGUMENT_PREFIX_CHAR[0]) {
+        return split;
+    }
+
+    bool is_long   = token[1] == CARGS__ARGUMENT_PREFIX_CHAR[0] && token[2] != '\0';
+    split.name     = is_long ? token + 1 : token;
+    split.name_len = 0;
+    while (split.name[split.name_len] != '\0' && split.name[split.name_len] != '=') {
+        split.name_len++;
+    }
+    split.value = (split.name[split.name_len] == '=') ? split.name + split.name_len + 1 : NULL;
+
+    if ((split.arg = CARGS__find_by_token (parser, split.name, split.name_len)) != NULL) {
+        split.kind = CARGS__TOKEN_NAME;
+    } else if (!is_long && split.value == NULL &&
+               CARGS__is_bundle (parser, split.name, split.name_len)) {
+        split.kind = CARGS__TOKEN_BUNDLE;
+    } else if (current_arg != NULL && CARGS__is_prefixed_value (current_arg, token)) {
+        split.kind  = CARGS__TOKEN_VALUE;
+        split.value = token;
+    } else {
+        split.kind = CARGS__TOKEN_UNKNOWN;
+    }
+    return split;
+}
+
+// Reports a name in the command line which did not match any argument, either because it is the
+// prefix of more than one name or with the closest name, if there is one. Returns false.
+static bool CARGS__report_unknown (Cargs_Parser* parser, const char* token,
+                                   const CARGS__Token* split)
+{
+    const CARGS__TrieNode* node = (split->name_len > 1)
+                                      ? CARGS__trie_find (parser, split->name, split->name_len)
+                                      : NULL;
+    if (node != NULL && node->name_count > 1) {
+        const char* names[4];
+        size_t count = CARGS__trie_collect (parser, node, names, CARGS__ARRAY_LEN (names), 0);
+
+        char buffer[256];
+        size_t len = 0;
+        buffer[0]  = '\0';
+        for (size_t i = 0; i < count && len < sizeof (buffer); i++) {
+            len += (size_t)snprintf (buffer + len, sizeof (buffer) - len, "%s%s",
+                                     (i > 0) ? ", " : "", names[i]);
+        }
+        CARGS_ERROR (false, "Argument '%s' is ambiguous, it can be %s%s", token, buffer,
+                     (node->name_count > count) ? ", ..." : "");
+    }
+
+    const CARGS__Argument* suggestion = CARGS__suggest (parser, split->name, split->name_len);
+    if (suggestion != NULL) {
+        CARGS_ERROR (false, "Unknown argument '%s', did you mean '%s'?", token, suggestion->name);
+    }
+    CARGS_ERROR (false, "Unknown argument '%s'", token);
+}
+
+// Marks the argument as given in the command line. Flags have no value, so they are set here.
+static bool CARGS__parse_name (Cargs_Parser* parser, CARGS__Argument* the_arg,
+                               bool* is_help_found)
+{
+    CARGS__BITSET_SET (parser->CARGS__given, the_arg->index);
+
+    // Non list arguments must be provided only once
+    if ((!the_arg->interface.CARGS__allow_multiple && the_arg->dirty)) {
+        CARGS_ERROR (false, "Argument '%s' provided more than once", the_arg->name);
+    }
+
+    // Flags do not have a value, so we have to call parse_string (which sets a calculated
+    // value to the flag argument) now when it is first detected.
+    if (the_arg->interface.CARGS__is_flag) {
+        // Args updated during parsing are flaged dirty
+        the_arg->dirty = true;
+
+        the_arg->provided = CARGS__parse_string (
+            parser, &the_arg->interface, the_arg->name,
+            CARGS__SLICE_OF (the_arg->interface.CARGS__value, the_arg->interface.type_size));
+
+        assert (the_arg->provided); // Parsing of flags cannot fail, because it takes no value.
+
+        // Special case for Help. If a help flag is found we skip the rest of the
+        // parsing and simply return.
+        if (strcmp ("help", the_arg->interface.CARGS__name) == 0) {
+            *is_help_found = true;
+        }
+    }
+    return true;
+}
+
+static bool CARGS__parse_value (Cargs_Parser* parser, CARGS__Argument* the_arg, const char* value)
+{
+    if (CARGS__is_list (&the_arg->interface)) {
+        // Values from the command line replace the default value(s).
+        if (!the_arg->dirty) {
+            ((Cargs_ArrayList*)the_arg->interface.CARGS__value)->len = 0;
+        }
+        the_arg->provided = CARGS__parse_list_values (parser, &the_arg->interface, value);
+    } else {
+        // Provided must only be set if default value is set, otherwise must be reset.
+        assert (CARGS__is_stream (&the_arg->interface) ||
+                (the_arg->default_value && the_arg->provided) ||
+                (!the_arg->default_value && !the_arg->provided));
+
+        the_arg->provided = the_arg->interface.CARGS__is_lazy
+                                ? CARGS__assign_lazy (the_arg, value)
+                                : CARGS__parse_string (
+                                      parser, &the_arg->interface, value,
+                                      CARGS__SLICE_OF (the_arg->interface.CARGS__value,
+                                                       the_arg->interface.type_size));
+    }
+
+    if (!the_arg->provided) {
+        CARGS_ERROR (false, "Invalid '%s' argument value: '%s'", the_arg->name, value);
+    }
+
+    if (CARGS__is_stream (&the_arg->interface) &&
+        !the_arg->interface.CARGS__on_value (the_arg->interface.CARGS__value)) {
+        CARGS_ERROR (false, "Argument '%s' value '%s' was not accepted", the_arg->name, value);
+    }
+
+    // Args updated during parsing are flaged dirty
+    the_arg->dirty = true;
+    return true;
+}
+
+// Parses one command line token, which is either an argument name (with or without a value), a
+// bundle of flags or a value for the current argument (the last argument name found).
+bool CARGS__parse_token (Cargs_Parser* parser, const char* token, CARGS__Argument** current_arg,
+                         bool* is_help_found)
+{
+    // Most tokens are values, or names given without a value, which need no splitting.
+    if (*current_arg != NULL && CARGS__is_plain_value (parser, *current_arg, token)) {
+        return CARGS__parse_value (parser, *current_arg, token);
+    }
+    CARGS__Argument* the_arg = CARGS__find_by_span (parser, token, strlen (token));
+    if (the_arg != NULL) {
+        *current_arg = the_arg;
+        return CARGS__parse_name (parser, the_arg, is_help_found);
+    }
+
+    CARGS__Token split = CARGS__split_token (parser, token, *current_arg);
+
+    switch (split.kind) {
+    case CARGS__TOKEN_NAME:
+        *current_arg = split.arg;
+        if (!CARGS__parse_name (parser, split.arg, is_help_found)) {
+            return false;
+        }
+        if (*is_help_found || split.value == NULL) {
+            return true;
+        }
+        if (split.arg->interface.CARGS__is_flag) {
+            CARGS_ERROR (false, "Argument '%s' does not take a value", split.arg->name);
+        }
+        return CARGS__parse_value (parser, split.arg, split.value);
+    case CARGS__TOKEN_BUNDLE:
+        for (size_t i = 1; i < split.name_len && !*is_help_found; i++) {
+            const char short_name[] = { CARGS__ARGUMENT_PREFIX_CHAR[0], split.name[i] };
+            *current_arg            = CARGS__find_by_span (parser, short_name, 2);
+            if (!CARGS__parse_name (parser, *current_arg, is_help_found)) {
+                return false;
+            }
+        }
+        return true;
+    case CARGS__TOKEN_VALUE:
+        if (*current_arg == NULL) {
+            CARGS_ERROR (false, "Value '%s' is not of any argument", token);
+        }
+        return CARGS__parse_value (parser, *current_arg, token);
+    case CARGS__TOKEN_UNKNOWN:
+        break;
+    }
+    return CARGS__report_unknown (parser, token, &split);
+}
+
+    #ifdef CARGS__RESPONSE_FILES_ENABLED
+// true if the token (of the command line) is a response file (@file) or an escaped '@' (@@text),
+// which is the token after the first '@'.
+static bool CARGS__is_response_file_token (const Cargs_Parser* parser, const char* token)
+{
+    return !parser->CARGS__is_response_files_off &&
+           token[0] == CARGS__RESPONSE_FILE_PREFIX_CHAR[0] && token[1] != '\0';
+}
+
+// Splits response file text into null terminated tokens, in place, and parses them. Tokens are
+// either separated by null bytes (if the text has any) or by new lines. In the later case a token
+// can be put in double quotes, which can then have new lines, \" and \\ in it.
+// Text must be followed by a null byte (text[len] == '\0').
+bool CARGS__parse_response_file_tokens (Cargs_Parser* parser, char* text, size_t len,
+                                        CARGS__Argument** current_arg, bool* is_help_found)
+{
+    bool is_null_delimited = memchr (text, '\0', len) != NULL;
+    char* end              = text + len;
+
+    for (char* cur = text; cur < end && !*is_help_found;) {
+        char* token = cur;
+
+        if (is_null_delimited) {
+            cur += strlen (cur) + 1; // Bound by the null byte after the text
+            if (*token == '\0') {
+                continue; // Skip empty tokens
+            }
+        } else if (*cur == '\n' || *cur == '\r') {
+            cur++;
+            continue; // Skip empty lines
+        } else if (*cur == '"') {
+            // Unquote in place, the token moves back by one char over the opening quote.
+            char* out = token;
+            for (cur++; cur < end && *cur != '"'; cur++) {
+                if (*cur == '\\' && cur + 1 < end && (cur[1] == '"' || cur[1] == '\\')) {
+                    cur++;
+                }
+                *out++ = *cur;
+            }
+            if (cur >= end) {
+                CARGS_ERROR (false, "Missing closing quote in response file");
+            }
+            *out = '\0';
+
+            cur++; // Closing quote
+            cur += (*cur == '\r');
+            if (cur < end && *cur != '\n') {
+                CARGS_ERROR (false, "Unexpected text after quoted token '%s' in response file",
+                             token);
+            }
+        } else {
+            char* line_end = (char*)memchr (cur, '\n', (size_t)(end - cur));
+            if (line_end == NULL) {
+                line_end = end;
+            }
+            cur = line_end + 1;
+
+            // Drop '\r' of Windows line endings
+            if (line_end > token && line_end[-1] == '\r') {
+                line_end--;
+            }
+            *line_end = '\0';
+        }
+
+        if (!CARGS__parse_token (parser, token, current_arg, is_help_found)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Memory maps the response file and parses the tokens in it, without copying them. Mapping is kept
+// till cargs_cleanup, since values (StringView for example) can point into it.
+bool CARGS__parse_response_file (Cargs_Parser* parser, const char* path,
+                                 CARGS__Argument** current_arg, bool* is_help_found)
+{
+    int fd = open (path, O_RDONLY);
+    if (fd < 0) {
+        CARGS_ERROR (false, "Cannot read response file '%s': %s", path, strerror (errno));
+    }
+
+    struct stat st;
+    char* text = MAP_FAILED;
+    size_t len = 0;
+
+    if (fstat (fd, &st) == 0) {
+        len = (size_t)st.st_size;
+
+        // File is mapped over a (zero filled) anonymous mapping which is a byte longer, so the text
+        // is always followed by a null byte. Mapping is private, tokens are terminated in place.
+        text = (char*)mmap (NULL, len + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                            -1, 0);
+        if (text != MAP_FAILED && len > 0 &&
+            mmap (text, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+                MAP_FAILED) {
+            int mmap_errno = errno;
+            munmap (text, len + 1);
+            text  = MAP_FAILED;
+            errno = mmap_errno;
+        }
+    }
+
+    int saved_errno = errno;
+    close (fd);
+
+    if (text == MAP_FAILED) {
+        CARGS_ERROR (false, "Cannot read response file '%s': %s", path, strerror (saved_errno));
+    }
+
+    if (parser->CARGS__response_files == NULL) {
+        parser->CARGS__response_files = CARGS__arl_new_with_capacity (&parser->CARGS__arena, 4,
+                                                                      sizeof (Cargs_Slice));
+    }
+    Cargs_Slice mapping = CARGS__SLICE_OF (text, len + 1);
+    CARGS__arl_push (parser->CARGS__response_files, &mapping);
+
+    return CARGS__parse_response_file_tokens (parser, text, len, current_arg, is_help_found);
+}
+    #endif // CARGS__RESPONSE_FILES_ENABLED
+
+// Parses all the tokens of the command line (and the response files in it).
+static bool CARGS__parse_tokens (Cargs_Parser* parser, char** argv, bool* is_help_found)
+{
+    CARGS__Argument* the_arg = NULL;
+
+    argv++; // Skip first argument
+    for (char* arg = NULL; !*is_help_found && (arg = *argv) != NULL; argv++) {
+    #ifdef CARGS__RESPONSE_FILES_ENABLED
+        if (CARGS__is_response_file_token (parser, arg)) {
+            arg++;
+            if (arg[0] != CARGS__RESPONSE_FILE_PREFIX_CHAR[0]) {
+                if (!CARGS__parse_response_file (parser, arg, &the_arg, is_help_found)) {
+                    return false;
+                }
+                continue;
+            }
+        }
+    #endif // CARGS__RESPONSE_FILES_ENABLED
+
+        if (!CARGS__parse_token (parser, arg, &the_arg, is_help_found)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Counts the values given to every list argument in the command line, and grows the lists once to
+// their final size, so there is no reallocation while parsing. Values in response files are not
+// counted, their lists still grow as the values are parsed. Parsers without list arguments skip it,
+// so their tokens are looked up only once.
+static void CARGS__presize_lists (Cargs_Parser* parser, char** argv)
+{
+    CARGS__Argument* the_arg = NULL;
+
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        parser->CARGS__args[i]->value_count = 0;
+    }
+
+    for (argv++; *argv != NULL; argv++) {
+        const char* token = *argv;
+    #ifdef CARGS__RESPONSE_FILES_ENABLED
+        if (CARGS__is_response_file_token (parser, token)) {
+            token++;
+            if (token[0] != CARGS__RESPONSE_FILE_PREFIX_CHAR[0]) {
+                the_arg = NULL; // Current argument after the file is not known without reading it.
+                continue;
+            }
+        }
+    #endif // CARGS__RESPONSE_FILES_ENABLED
+
+        // Tokens are split as they are when parsing (with the same fast path for values and names
+        // given without a value), so the values are of the same arguments.
+        const char* value = token;
+        if (the_arg == NULL || !CARGS__is_plain_value (parser, the_arg, token)) {
+            CARGS__Argument* named = CARGS__find_by_span (parser, token, strlen (token));
+            CARGS__Token split     = { .kind = CARGS__TOKEN_NAME, .arg = named };
+            if (named == NULL) {
+                split = CARGS__split_token (parser, token, the_arg);
+            }
+
+            if (split.kind == CARGS__TOKEN_NAME) {
+                the_arg = split.arg;
+            } else if (split.kind == CARGS__TOKEN_BUNDLE) {
+                const char short_name[] = { CARGS__ARGUMENT_PREFIX_CHAR[0],
+                                            split.name[split.name_len - 1] };
+                the_arg                 = CARGS__find_by_span (parser, short_name, 2);
+            } else if (split.kind == CARGS__TOKEN_UNKNOWN) {
+                the_arg = NULL; // Parsing fails on it
+            }
+            value = split.value;
+        }
+
+        if (the_arg != NULL && value != NULL && CARGS__is_list (&the_arg->interface)) {
+            the_arg->value_count += (the_arg->interface.CARGS__delimiters == NULL)
+                                        ? 1
+                                        : CARGS__count_delimited_values (
+                                              value, strlen (value),
+                                              the_arg->interface.CARGS__delimiters);
+        }
+    }
+
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* arg = parser->CARGS__args[i];
+        if (arg->value_count > 0) {
+            // Values from the command line replace the default value(s).
+            Cargs_ArrayList* list = (Cargs_ArrayList*)arg->interface.CARGS__value;
+            if (arg->value_count > list->capacity) {
+                CARGS__arl_reserve (list, arg->value_count);
+                CARGS__STATS (parser->CARGS__stats.list_growth_count++);
+            }
+        }
+    }
+}
+
+// Checks done after the command line is parsed.
+static bool CARGS__validate (Cargs_Parser* parser)
+{
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* the_arg = parser->CARGS__args[i];
+        if (CARGS__is_arg_enabled (parser, the_arg)) {
+            // Argument is enabled but not provided.
+            if (!the_arg->provided) {
+                CARGS_ERROR (false, "Argument '%s' is required but was not provided",
+                             the_arg->name);
+            }
+
+            // Streams get their default value (parsed when the argument was added) now.
+            if (CARGS__is_stream (&the_arg->interface) && !the_arg->dirty &&
+                !the_arg->interface.CARGS__on_value (the_arg->interface.CARGS__value)) {
+                CARGS_ERROR (false, "Argument '%s' default value '%s' was not accepted",
+                             the_arg->name, the_arg->default_value);
+            }
+        } else {
+            // Argument is not enabled but was provided.
+            if (the_arg->dirty) {
+                CARGS_ERROR (false, "Argument '%s' has no effect", the_arg->name);
+            }
+        }
+    }
+
+    return CARGS__check_groups (parser);
+}
+
+bool cargs_parser_parse_input (Cargs_Parser* parser, int argc, char** argv)
+{
+    bool is_help_found = false;
+
+    if (parser->CARGS__is_frozen) {
+        CARGS_ERROR (false, "Frozen parser can only be used as a schema for batch parsing");
+    }
+
+    CARGS__reset_conditions (parser); // Values are about to change
+    if (parser->CARGS__given != NULL) {
+        memset (parser->CARGS__given, 0,
+                sizeof (uint64_t) * CARGS__BITSET_WORDS (parser->CARGS__arg_capacity));
+    }
+
+    CARGS_UNUSED (argc);
+    CARGS__STATS (CARGS__StatsTimer timer = CARGS__stats_start (parser));
+    if (parser->CARGS__list_count > 0) {
+        CARGS__presize_lists (parser, argv);
+    }
+    bool is_ok = CARGS__parse_tokens (parser, argv, &is_help_found);
+    CARGS__STATS (parser->CARGS__stats.tokenize_ns += CARGS__stats_elapsed (parser, timer));
+
+    // Special case for Help. If a help flag is found we skip the rest of the parsing and simply
+    // return.
+    if (!is_ok || is_help_found) {
+        return is_ok;
+    }
+
+    CARGS__STATS (timer = CARGS__stats_start (parser));
+    is_ok = CARGS__validate (parser);
+    CARGS__STATS (parser->CARGS__stats.validate_ns += CARGS__stats_elapsed (parser, timer));
+    return is_ok;
+}
+
+bool cargs_parse_input (int argc, char** argv)
+{
+    return cargs_parser_parse_input (&CARGS__default_parser, argc, argv);
+}
+
+    #ifdef CARGS_ENABLE_BATCH_PARSE
+/*******************************************************************************************
+ * Batch parsing
+ *********************************************************************************************/
+        #define CARGS__BATCH_CHUNK_SIZE 64 // Number of jobs a worker takes at a time
+
+// Allocator of the schema, called by the workers one at a time, if it is not thread safe.
+typedef struct {
+    Cargs_Allocator allocator;
+    Cargs_Allocator* target;
+    pthread_mutex_t mutex;
+} CARGS__LockedAllocator;
+
+static void* CARGS__locked_reallocate (Cargs_Allocator* self, void* ptr, size_t old_size,
+                                       size_t new_size)
+{
+    CARGS__LockedAllocator* locked = CARGS_PARENT_OF (self, CARGS__LockedAllocator, allocator);
+    pthread_mutex_lock (&locked->mutex);
+    void* new_ptr = locked->target->reallocate (locked->target, ptr, old_size, new_size);
+    pthread_mutex_unlock (&locked->mutex);
+    return new_ptr;
+}
+
+static void CARGS__locked_deallocate (Cargs_Allocator* self, void* ptr, size_t size)
+{
+    CARGS__LockedAllocator* locked = CARGS_PARENT_OF (self, CARGS__LockedAllocator, allocator);
+    pthread_mutex_lock (&locked->mutex);
+    locked->target->deallocate (locked->target, ptr, size);
+    pthread_mutex_unlock (&locked->mutex);
+}
+
+typedef struct {
+    const Cargs_Parser* schema;
+    Cargs_Allocator* allocator; // Of the workers
+    Cargs_BatchJob* jobs;
+    size_t job_count;
+    size_t next_job;     // First job not yet taken by a worker. Updated atomically.
+    size_t failed_count; // Updated atomically.
+    Cargs_BatchResultFn on_result;
+    void* user_data;
+} CARGS__Batch;
+
+// Brings back the arguments to the state they were in just after they were added, so the same
+// parser can parse the next job.
+static void CARGS__reset_parser (Cargs_Parser* parser)
+{
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* arg = parser->CARGS__args[i];
+        arg->dirty           = false;
+        arg->provided        = arg->default_value != NULL;
+
+        if (CARGS__is_list (&arg->interface)) {
+            Cargs_ArrayList* list = (Cargs_ArrayList*)arg->interface.CARGS__value;
+            list->len             = 0;
+            if (arg->default_value != NULL) {
+                CARGS__parse_list_values (parser, &arg->interface, arg->default_value);
+            }
+        } else {
+            memset (arg->interface.CARGS__value, 0, arg->interface.type_size);
+            if (arg->interface.CARGS__is_lazy) {
+                CARGS__assign_lazy (arg, arg->default_value);
+            } else {
+                CARGS__assign_value (parser, &arg->interface, arg->default_value);
+            }
+        }
+    }
+    CARGS__unmap_response_files (parser);
+}
+
+static void* CARGS__batch_worker (void* data)
+{
+    CARGS__Batch* batch       = (CARGS__Batch*)data;
+    const CARGS__Arena memory = { .allocator = batch->allocator }; // Heap of the worker
+    Cargs_Parser* parser      = (Cargs_Parser*)CARGS__heap_alloc (&memory, NULL, 0,
+                                                                  sizeof (Cargs_Parser));
+    if (parser == NULL) {
+        perror ("[CARGS: ERROR] Allocation failed");
+        cargs_panic (NULL);
+    }
+    memset (parser, 0, sizeof (Cargs_Parser));
+    parser->CARGS__arena.allocator       = batch->allocator;
+    parser->CARGS__is_response_files_off = batch->schema->CARGS__is_response_files_off;
+
+    // Worker has its own copy of the arguments (and so the values). Schema is only read.
+    const Cargs_Parser* schema = batch->schema;
+    for (unsigned i = 0; i < schema->CARGS__arg_count; i++) {
+        const CARGS__Argument* arg = schema->CARGS__args[i];
+        if (arg->condition.when_name != NULL) {
+            CARGS__parser_add_when_arg (parser, arg->condition.when_name,
+                                        arg->condition.when_value, arg->name, arg->description,
+                                        arg->interface, arg->default_value);
+        } else {
+            CARGS__parser_add_arg (parser, arg->name, arg->description, arg->interface,
+                                   arg->default_value, arg->condition.is_enabled_fn,
+                                   arg->condition.description);
+        }
+    }
+    // Arguments were added in the same order, so they have the same bits in the groups. Worker
+    // groups are sized for all the arguments, schema groups only for those added before them (the
+    // rest of the words are left zero).
+    for (unsigned g = 0; g < schema->CARGS__group_count; g++) {
+        const CARGS__Group* schema_group = &schema->CARGS__groups[g];
+        CARGS__Group* group              = CARGS__new_group (parser, schema_group->kind);
+        if (group != NULL) {
+            unsigned word_count = CARGS__MIN (group->word_count, schema_group->word_count);
+            for (unsigned w = 0; w < word_count; w++) {
+                group->members[w] = schema_group->members[w];
+            }
+            parser->CARGS__group_count++;
+        }
+    }
+
+    size_t start = 0;
+    while ((start = __atomic_fetch_add (&batch->next_job, CARGS__BATCH_CHUNK_SIZE,
+                                        __ATOMIC_RELAXED)) < batch->job_count) {
+        size_t end = CARGS__MIN (start + CARGS__BATCH_CHUNK_SIZE, batch->job_count);
+        for (size_t i = start; i < end; i++) {
+            Cargs_BatchJob* job = &batch->jobs[i];
+            if (!(job->is_ok = cargs_parser_parse_input (parser, job->argc, job->argv))) {
+                __atomic_fetch_add (&batch->failed_count, 1, __ATOMIC_RELAXED);
+            }
+            if (batch->on_result != NULL) {
+                batch->on_result (i, parser, batch->user_data);
+            }
+            CARGS__reset_parser (parser);
+        }
+    }
+
+    cargs_parser_cleanup (parser);
+    CARGS__heap_free (&memory, parser, sizeof (Cargs_Parser));
+    return NULL;
+}
+
+bool cargs_parse_batch (const Cargs_Parser* schema, Cargs_BatchJob* jobs, size_t job_count,
+                        unsigned thread_count, Cargs_BatchResultFn on_result, void* user_data)
+{
+    if (!schema->CARGS__is_frozen) {
+        CARGS_ERROR (false, "Parser must be frozen before it is used for batch parsing");
+    }
+
+    if (thread_count == 0) {
+        long cpu_count = sysconf (_SC_NPROCESSORS_ONLN);
+        thread_count   = (cpu_count > 0) ? (unsigned)cpu_count : 1;
+    }
+    // More workers than there are chunks of jobs would have nothing to do.
+    size_t chunk_count = (job_count + CARGS__BATCH_CHUNK_SIZE - 1) / CARGS__BATCH_CHUNK_SIZE;
+    thread_count       = (unsigned)CARGS__MAX (CARGS__MIN (thread_count, chunk_count), 1);
+
+    // Workers allocate through the allocator of the schema (not from its arena, which is not thread
+    // safe), which is locked if the workers cannot call it at once.
+    CARGS__LockedAllocator locked = {
+        .allocator = { .reallocate     = CARGS__locked_reallocate,
+                       .deallocate     = CARGS__locked_deallocate,
+                       .is_thread_safe = true },
+        .target    = CARGS__allocator_of (&schema->CARGS__arena),
+    };
+    bool is_locked = thread_count > 1 && !locked.target->is_thread_safe;
+    if (is_locked) {
+        pthread_mutex_init (&locked.mutex, NULL);
+    }
+
+    CARGS__Batch batch = {
+        .schema       = schema,
+        .allocator    = is_locked ? &locked.allocator : locked.target,
+        .jobs         = jobs,
+        .job_count    = job_count,
+        .next_job     = 0,
+        .failed_count = 0,
+        .on_result    = on_result,
+        .user_data    = user_data,
+    };
+
+    // Calling thread is also a worker. If a thread cannot be started, the ones which were started
+    // (and the calling thread) take its share of jobs.
+    pthread_t* threads = NULL;
+    unsigned started   = 0;
+    if (thread_count > 1) {
+        threads = (pthread_t*)CARGS__heap_alloc (&schema->CARGS__arena, NULL, 0,
+                                                 sizeof (pthread_t) * (thread_count - 1));
+        if (threads == NULL) {
+            perror ("[CARGS: ERROR] Allocation failed");
+            cargs_panic (NULL);
+        }
+        for (; started < thread_count - 1; started++) {
+            if (pthread_create (&threads[started], NULL, CARGS__batch_worker, &batch) != 0) {
+                break;
+            }
+        }
+    }
+
+    CARGS__batch_worker (&batch);
+
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join (threads[i], NULL);
+    }
+    CARGS__heap_free (&schema->CARGS__arena, threads, sizeof (pthread_t) * (thread_count - 1));
+    if (is_locked) {
+        pthread_mutex_destroy (&locked.mutex);
+    }
+
+    return batch.failed_count == 0;
+}
+    #endif // CARGS_ENABLE_BATCH_PARSE
+
+        #define CARGS__HELP_STACK_BUFFER_SIZE 4096 // Larger help messages are rendered on the heap
+
+// Help message is rendered into memory and written at once, instead of by many small writes.
+typedef struct {
+    char* buffer;
+    size_t size;
+    size_t len;       // Length of the whole message, even the part which did not fit in buffer
+    bool is_growable; // buffer is grown (on the heap) when the message does not fit in it
+    bool is_on_heap;
+    const CARGS__Arena* memory; // Allocator (of the parser) of the buffer on the heap
+} CARGS__HelpWriter;
+
+static void CARGS__help_append (CARGS__HelpWriter* writer, const char* format, ...)
+{
+    va_list args;
+    for (;;) {
+        size_t available = (writer->len < writer->size) ? writer->size - writer->len : 0;
+
+        va_start (args, format);
+        int written = vsnprintf ((available > 0) ? writer->buffer + writer->len : NULL, available,
+                                 format, args);
+        va_end (args);
+
+        if (written < 0) {
+            return;
+        }
+        if ((size_t)written < available || !writer->is_growable) {
+            writer->len += (size_t)written;
+            return;
+        }
+
+        size_t new_size = CARGS__MAX (writer->size * 2, writer->len + (size_t)written + 1);
+        char* new_buffer = (char*)CARGS__heap_alloc (writer->memory,
+                                                     writer->is_on_heap ? writer->buffer : NULL,
+                                                     writer->is_on_heap ? writer->size : 0,
+                                                     new_size);
+        if (new_buffer == NULL) {
+            writer->is_growable = false; // Message is cut short
+            continue;
+        }
+        if (!writer->is_on_heap) {
+            memcpy (new_buffer, writer->buffer, writer->len);
+        }
+        writer->buffer     = new_buffer;
+        writer->size       = new_size;
+        writer->is_on_heap = true;
+    }
+}
+
+static void CARGS__format_help_message (Cargs_Parser* parser, CARGS__HelpWriter* writer,
+                                        CARGS__Argument* arg)
+{
+    const char* arg_name_color = (!CARGS__is_arg_enabled (parser, arg)) ? CARGS__COL_DISABLED_ARG
+                                                                        : CARGS__COL_ENABLED_ARG;
+
+    const char* list_indication_str = (arg->interface.CARGS__allow_multiple)
+                                          ? CARGS__LIST_MARKING_STRING
+                                          : "";
+
+    int name_width = (int)parser->CARGS__help_name_width;
+
+    // List marking is printed right after format help, and together they fill the column.
+    assert (parser->CARGS__help_format_width >= arg->format_help_len);
+    int arg_format_help_len = (int)(parser->CARGS__help_format_width - arg->format_help_len +
+                                    strlen (list_indication_str));
+
+    if (arg->condition.description == NULL && arg->condition.when_name != NULL) {
+        CARGS__help_append (writer, "%s%-*s%s %s%-*s When %s is %s. %s", arg_name_color,
+                            name_width, arg->name, CARGS__COL_RESET, arg->interface.format_help,
+                            arg_format_help_len, list_indication_str, arg->condition.when_name,
+                            arg->condition.when_value, arg->description);
+    } else if (arg->condition.description == NULL) {
+        CARGS__help_append (writer, "%s%-*s%s %s%-*s %s", arg_name_color, name_width, arg->name,
+                            CARGS__COL_RESET, arg->interface.format_help, arg_format_help_len,
+                            list_indication_str, arg->description);
+    } else {
+        CARGS__help_append (writer, "%s%-*s%s %s%-*s %s. %s", arg_name_color, name_width,
+                            arg->name, CARGS__COL_RESET, arg->interface.format_help,
+                            arg_format_help_len, list_indication_str, arg->condition.description,
+                            arg->description);
+    }
+
+    if (arg->default_value) {
+        CARGS__help_append (writer, " %s(Defaults to '%s')\n%s", CARGS__COL_DEFAULS,
+                            arg->default_value, CARGS__COL_RESET);
+    } else {
+        CARGS__help_append (writer, " %s(%s)%s\n", CARGS__COL_REQUIRED, "Required",
+                            CARGS__COL_RESET);
+    }
+}
+
+static void CARGS__format_help (Cargs_Parser* parser, CARGS__HelpWriter* writer)
+{
+    assert (parser->CARGS__help_name_width > 0 &&
+            parser->CARGS__help_name_width <= CARGS_MAX_INPUT_VALUE_LEN);
+
+    size_t conditional_arg_count = 0;
+
+    CARGS__help_append (writer, "Usage:\n");
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* the_arg = parser->CARGS__args[i];
+        if (!CARGS__is_conditional (the_arg)) {
+            CARGS__format_help_message (parser, writer, the_arg);
+        } else {
+            conditional_arg_count++;
+        }
+    }
+
+    if (conditional_arg_count == 0) {
+        return; // No conditional arguments
+    }
+
+    CARGS__help_append (writer, "\nConditional ");
+    #ifndef CARGS_DISABLE_COLORS
+    CARGS__help_append (writer, "(shows %sAvailable%s & %sDisabled%s) arguments:",
+                        CARGS__COL_ENABLED_ARG, CARGS__COL_RESET, CARGS__COL_DISABLED_ARG,
+                        CARGS__COL_RESET);
+    #endif // CARGS_DISABLE_COLORS
+    CARGS__help_append (writer, "\n");
+
+    for (unsigned i = 0; i < parser->CARGS__arg_count; i++) {
+        CARGS__Argument* the_arg = parser->CARGS__args[i];
+        if (CARGS__is_conditional (the_arg)) {
+            CARGS__format_help_message (parser, writer, the_arg);
+        }
+    }
+}
+
+size_t cargs_parser_format_help (Cargs_Parser* parser, char* buffer, size_t size)
+{
+    CARGS__HelpWriter writer = { .buffer = buffer, .size = size };
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+    CARGS__format_help (parser, &writer);
+    return writer.len;
+}
+
+size_t cargs_complete (const char* prefix, const char** names, size_t size)
+{
+    return cargs_parser_complete (&CARGS__default_parser, prefix, names, size);
+}
+
+size_t cargs_format_help (char* buffer, size_t size)
+{
+    return cargs_parser_format_help (&CARGS__default_parser, buffer, size);
+}
+
+// Help message is written to stderr (which is unbuffered) with a single write.
+void cargs_parser_print_help (Cargs_Parser* parser)
+{
+    char stack_buffer[CARGS__HELP_STACK_BUFFER_SIZE];
+    CARGS__HelpWriter writer = { .buffer      = stack_buffer,
+                                 .size        = sizeof (stack_buffer),
+                                 .is_growable = true,
+                                 .memory      = &parser->CARGS__arena };
+
+    CARGS__format_help (parser, &writer);
+    fwrite (writer.buffer, 1, CARGS__MIN (writer.len, writer.size - 1), stderr);
+
+    if (writer.is_on_heap) {
+        CARGS__heap_free (writer.memory, writer.buffer, writer.size);
+    }
+}
+
+void cargs_print_help()
+{
+    cargs_parser_print_help (&CARGS__default_parser);
+}
+
+/*******************************************************************************************
+ * Interfaces
+ *********************************************************************************************/
+
+bool cargs_bool_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (bool));
+    CARGS_UNUSED (self);
+
+    if (strncmp ("true", input, CARGS_MAX_INPUT_VALUE_LEN) == 0) {
+        *(bool*)out.address = true;
+    } else if (strncmp ("false", input, CARGS_MAX_INPUT_VALUE_LEN) == 0) {
+        *(bool*)out.address = false;
+    } else {
+        return false;
     }
-    CARGS__arg_list_count = 0;
+
+    return true;
 }
 
-bool cargs_parse_input (int argc, char** argv)
+bool cargs_bool_check_string (struct Cargs_TypeInterface* self, const char* input)
 {
-    CARGS__Argument* the_arg = NULL;
-
-    CARGS_UNUSED (argc);
-    argv++; // Skip first argument
-    for (char* arg = NULL; (arg = *argv) != NULL; argv++) {
-        // TODO: argument value/parameter might start with CARGS__ARGUMENT_PREFIX_CHAR
-
-        if (arg[0] == CARGS__ARGUMENT_PREFIX_CHAR[0]) {
-            if (!(the_arg = CARGS__find_by_name (arg))) {
-                CARGS_ERROR (false, "Unknown argument '%s'", arg);
-            }
-
-            // Non list arguments must be provided only once
-            if ((!the_arg->interface.CARGS__allow_multiple && the_arg->dirty)) {
-                CARGS_ERROR (false, "Argument '%s' provided more than once", the_arg->name);
-            }
-
-            // Flags do not have a value, so we have to call parse_string (which sets a calculated
-            // value to the flag argument) now when it is first detected.
-            if (the_arg->interface.CARGS__is_flag) {
-                // Args updated during parsing are flaged dirty
-                the_arg->dirty = true;
-
-                the_arg->provided = the_arg->interface.parse_string (
-                    &the_arg->interface, arg,
-                    CARGS__SLICE_OF (the_arg->interface.CARGS__value,
-                                     the_arg->interface.type_size));
-
-                assert (the_arg->provided); // Parsing of flags cannot fail, because it takes no
-                                            // value.
+    CARGS_UNUSED (self);
+    return strncmp ("true", input, CARGS_MAX_INPUT_VALUE_LEN) == 0 ||
+           strncmp ("false", input, CARGS_MAX_INPUT_VALUE_LEN) == 0;
+}
 
-                // Special case for Help. If a help flag is found we skip the rest of the
-                // parsing and simply return.
-                if (strcmp ("help", the_arg->interface.CARGS__name) == 0) {
-                    goto exit;
-                }
-            }
-        } else {
-            assert (the_arg != NULL);
+    #define CARGS__MAX_INTEGER_LEN (1 + 2 + 64) // Sign, base prefix and 64 binary digits
 
-            Cargs_Slice output  = { 0 };
-            void* new_list_item = NULL;
+    #ifdef CARGS__SWAR_ENABLED
+// true if all 8 chars, loaded as a little endian word, are decimal digits.
+static bool CARGS__swar_is_eight_digits (uint64_t chunk)
+{
+    return (((chunk + 0x4646464646464646ull) | (chunk - 0x3030303030303030ull)) &
+            0x8080808080808080ull) == 0;
+}
 
-            if (the_arg->interface.CARGS__allow_multiple) {
-                Cargs_ArrayList* list = (Cargs_ArrayList*)the_arg->interface.CARGS__value;
+// Value of 8 decimal digits, loaded as a little endian word. Digits are combined in pairs, then
+// in fours and then in eights, so it takes 3 multiplications instead of 8.
+static uint64_t CARGS__swar_eight_digits_value (uint64_t chunk)
+{
+    const uint64_t mask = 0x000000FF000000FFull;
 
-                new_list_item = (list->len == 1 && !the_arg->dirty)
-                                    ? list->buffer
-                                    : CARGS__arl_push (list, NULL); // Dummy insert
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & mask) * (100 + (1000000ull << 32))) +
+            (((chunk >> 16) & mask) * (1 + (10000ull << 32)))) >>
+           32;
+}
+    #endif // CARGS__SWAR_ENABLED
 
-                assert (new_list_item != NULL);
-                output = CARGS__SLICE_OF (new_list_item, the_arg->interface.type_size);
-            } else {
-                // Provided must only be set if default value is set, otherwise must be reset.
-                assert ((the_arg->default_value && the_arg->provided) ||
-                        (!the_arg->default_value && !the_arg->provided));
+// Parses exactly len digits of the given base. Fails if there are no digits, any of the chars is
+// not a digit or if the value does not fit in 64 bits.
+static bool CARGS__parse_digits (const char* digits, size_t len, unsigned base, uint64_t* out)
+{
+    uint64_t value = 0;
+    size_t i       = 0;
 
-                output = CARGS__SLICE_OF (the_arg->interface.CARGS__value,
-                                          the_arg->interface.type_size);
-            }
+    if (len == 0) {
+        return false;
+    }
 
-            if (!(the_arg->provided = the_arg->interface.parse_string (&the_arg->interface, arg,
-                                                                       output))) {
-                CARGS_ERROR (false, "Invalid '%s' argument value: '%s'", the_arg->name, arg);
+    #ifdef CARGS__SWAR_ENABLED
+    if (base == 10) {
+        for (; len - i >= 8; i += 8) {
+            uint64_t chunk;
+            memcpy (&chunk, digits + i, sizeof (chunk));
+            if (!CARGS__swar_is_eight_digits (chunk) ||
+                __builtin_mul_overflow (value, 100000000ull, &value) ||
+                __builtin_add_overflow (value, CARGS__swar_eight_digits_value (chunk), &value)) {
+                return false;
             }
-
-            // Args updated during parsing are flaged dirty
-            the_arg->dirty = true;
         }
     }
-
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* the_arg = CARGS__arg_list[i];
-        if (CARGS__is_arg_enabled (the_arg)) {
-            // Argument is enabled but not provided.
-            if (!the_arg->provided) {
-                CARGS_ERROR (false, "Argument '%s' is required but was not provided",
-                             the_arg->name);
-            }
-        } else {
-            // Argument is not enabled but was provided.
-            if (the_arg->dirty) {
-                CARGS_ERROR (false, "Argument '%s' has no effect", the_arg->name);
-            }
+    #endif // CARGS__SWAR_ENABLED
+
+    for (; i < len; i++) {
+        unsigned char c     = (unsigned char)digits[i];
+        unsigned char lower = c | 0x20; // Lower case, if c is a letter
+        unsigned digit      = (c >= '0' && c <= '9')           ? (unsigned)(c - '0')
+                              : (lower >= 'a' && lower <= 'f') ? (unsigned)(lower - 'a' + 10)
+                                                               : UINT_MAX;
+        if (digit >= base || __builtin_mul_overflow (value, base, &value) ||
+            __builtin_add_overflow (value, digit, &value)) {
+            return false;
         }
     }
 
-exit:
+    *out = value;
     return true;
 }
 
-static void CARGS__print_help_message (CARGS__Argument* arg, size_t max_arg_name_len,
-                                       size_t max_arg_format_help_len)
+// Parses the full token, which is an optional sign, then an optional base prefix ('0' followed by
+// prefix_char, if prefix_char is not '\0') and then the digits. Nothing else is allowed.
+static bool CARGS__parse_integer (const char* input, unsigned base, char prefix_char,
+                                  bool* is_negative, uint64_t* magnitude)
 {
-    const char* arg_name_color = (arg->condition.is_enabled_fn != NULL &&
-                                  !arg->condition.is_enabled_fn())
-                                     ? CARGS__COL_DISABLED_ARG
-                                     : CARGS__COL_ENABLED_ARG;
+    size_t len      = strnlen (input, CARGS__MAX_INTEGER_LEN + 1);
+    const char* cur = input;
 
-    const char* list_indication_str = (arg->interface.CARGS__allow_multiple)
-                                          ? CARGS__LIST_MARKING_STRING
-                                          : "";
+    if (len > CARGS__MAX_INTEGER_LEN) {
+        return false;
+    }
+
+    *is_negative = (*cur == '-');
+    if (*cur == '-' || *cur == '+') {
+        cur++;
+    }
+    if (prefix_char != '\0' && cur[0] == '0' && (cur[1] | 0x20) == prefix_char) {
+        cur += 2;
+    }
+    return CARGS__parse_digits (cur, len - (size_t)(cur - input), base, magnitude);
+}
 
-    assert (max_arg_format_help_len >= strlen (arg->interface.format_help));
-    int arg_format_help_len = max_arg_format_help_len - strlen (arg->interface.format_help);
+static bool CARGS__parse_signed (const char* input, int64_t min, int64_t max, int64_t* out)
+{
+    bool is_negative   = false;
+    uint64_t magnitude = 0;
 
-    if (arg->condition.description == NULL) {
-        fprintf (stderr, "%s%-*s%s %s%-*s %s", arg_name_color, (int)max_arg_name_len, arg->name,
-                 CARGS__COL_RESET, arg->interface.format_help, arg_format_help_len,
-                 list_indication_str, arg->description);
-    } else {
-        fprintf (stderr, "%s%-*s%s %s%-*s %s. %s", arg_name_color, (int)max_arg_name_len, arg->name,
-                 CARGS__COL_RESET, arg->interface.format_help, arg_format_help_len,
-                 list_indication_str, arg->condition.description, arg->description);
+    if (!CARGS__parse_integer (input, 10, '\0', &is_negative, &magnitude)) {
+        return false;
     }
 
-    if (arg->default_value) {
-        fprintf (stderr, " %s(Defaults to '%s')\n%s", CARGS__COL_DEFAULS, arg->default_value,
-                 CARGS__COL_RESET);
+    if (is_negative) {
+        if (magnitude > (uint64_t)(-(min + 1)) + 1) {
+            return false;
+        }
+        *out = (magnitude == 0) ? 0 : -(int64_t)(magnitude - 1) - 1;
     } else {
-        fprintf (stderr, " %s(%s)%s\n", CARGS__COL_REQUIRED, "Required", CARGS__COL_RESET);
+        if (magnitude > (uint64_t)max) {
+            return false;
+        }
+        *out = (int64_t)magnitude;
     }
+    return true;
 }
 
-void cargs_print_help()
+static bool CARGS__parse_unsigned (const char* input, unsigned base, char prefix_char,
+                                   uint64_t max, uint64_t* out)
 {
-    size_t max_arg_name_len        = 0;
-    size_t max_arg_format_help_len = 0;
+    bool is_negative = false;
+    return CARGS__parse_integer (input, base, prefix_char, &is_negative, out) && !is_negative &&
+           *out <= max;
+}
 
-    size_t list_indication_string_len = strlen (CARGS__LIST_MARKING_STRING);
+bool cargs_int_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (int));
+    CARGS_UNUSED (self);
 
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* the_arg = CARGS__arg_list[i];
-        max_arg_name_len         = CARGS__MAX (strlen (the_arg->name), max_arg_name_len);
-        max_arg_format_help_len  = CARGS__MAX (max_arg_format_help_len,
-                                               (strlen (the_arg->interface.format_help) +
-                                               (the_arg->interface.CARGS__allow_multiple
-                                                     ? list_indication_string_len
-                                                     : 0)));
+    int64_t value = 0;
+    if (!CARGS__parse_signed (input, INT_MIN, INT_MAX, &value)) {
+        return false;
     }
+    *(int*)out.address = (int)value;
+    return true;
+}
 
-    assert (max_arg_name_len > 0 && max_arg_name_len <= CARGS_MAX_INPUT_VALUE_LEN);
-    assert (max_arg_format_help_len <= CARGS_MAX_INPUT_VALUE_LEN + list_indication_string_len);
+bool cargs_int_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    int64_t value = 0;
+    return CARGS__parse_signed (input, INT_MIN, INT_MAX, &value);
+}
 
-    size_t conditional_arg_count = 0;
+bool cargs_int64_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                               Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (int64_t));
+    CARGS_UNUSED (self);
 
-    fprintf (stderr, "Usage:\n");
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* the_arg = CARGS__arg_list[i];
-        if (the_arg->condition.is_enabled_fn == NULL) {
-            CARGS__print_help_message (the_arg, max_arg_name_len, max_arg_format_help_len);
-        } else {
-            conditional_arg_count++;
-        }
-    }
+    return CARGS__parse_signed (input, INT64_MIN, INT64_MAX, (int64_t*)out.address);
+}
 
-    if (conditional_arg_count == 0) {
-        return; // No conditional arguments
-    }
+bool cargs_int64_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    int64_t value = 0;
+    return CARGS__parse_signed (input, INT64_MIN, INT64_MAX, &value);
+}
 
-    fprintf (stderr, "\nConditional ");
-    #ifndef CARGS_DISABLE_COLORS
-    fprintf (stderr, "(shows %sAvailable%s & %sDisabled%s) arguments:", CARGS__COL_ENABLED_ARG,
-             CARGS__COL_RESET, CARGS__COL_DISABLED_ARG, CARGS__COL_RESET);
-    #endif // CARGS_DISABLE_COLORS
-    fprintf (stderr, "\n");
+bool cargs_uint64_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (uint64_t));
+    CARGS_UNUSED (self);
 
-    for (unsigned i = 0; i < CARGS__arg_list_count; i++) {
-        CARGS__Argument* the_arg = CARGS__arg_list[i];
-        if (the_arg->condition.is_enabled_fn != NULL) {
-            CARGS__print_help_message (the_arg, max_arg_name_len, max_arg_format_help_len);
-        }
-    }
+    return CARGS__parse_unsigned (input, 10, '\0', UINT64_MAX, (uint64_t*)out.address);
 }
 
-/*******************************************************************************************
- * Interfaces
- *********************************************************************************************/
+bool cargs_uint64_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    uint64_t value = 0;
+    return CARGS__parse_unsigned (input, 10, '\0', UINT64_MAX, &value);
+}
 
-bool cargs_bool_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
+bool cargs_size_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
 {
     assert (self != NULL);
     assert (self->CARGS__value != NULL);
-    assert (out.len == sizeof (bool));
+    assert (out.len == sizeof (size_t));
     CARGS_UNUSED (self);
 
-    if (strncmp ("true", input, CARGS_MAX_INPUT_VALUE_LEN) == 0) {
-        *(bool*)out.address = true;
-    } else if (strncmp ("false", input, CARGS_MAX_INPUT_VALUE_LEN) == 0) {
-        *(bool*)out.address = false;
-    } else {
+    uint64_t value = 0;
+    if (!CARGS__parse_unsigned (input, 10, '\0', SIZE_MAX, &value)) {
         return false;
     }
-
+    *(size_t*)out.address = (size_t)value;
     return true;
 }
 
-bool cargs_int_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
+bool cargs_size_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    uint64_t value = 0;
+    return CARGS__parse_unsigned (input, 10, '\0', SIZE_MAX, &value);
+}
+
+bool cargs_hex_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
 {
     assert (self != NULL);
     assert (self->CARGS__value != NULL);
-    assert (out.len == sizeof (int));
+    assert (out.len == sizeof (uint64_t));
+    CARGS_UNUSED (self);
+
+    return CARGS__parse_unsigned (input, 16, 'x', UINT64_MAX, (uint64_t*)out.address);
+}
+
+bool cargs_hex_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    uint64_t value = 0;
+    return CARGS__parse_unsigned (input, 16, 'x', UINT64_MAX, &value);
+}
+
+bool cargs_octal_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                               Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (uint64_t));
+    CARGS_UNUSED (self);
+
+    return CARGS__parse_unsigned (input, 8, 'o', UINT64_MAX, (uint64_t*)out.address);
+}
+
+bool cargs_octal_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    uint64_t value = 0;
+    return CARGS__parse_unsigned (input, 8, 'o', UINT64_MAX, &value);
+}
+
+bool cargs_binary_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (uint64_t));
     CARGS_UNUSED (self);
 
-    // TODO: strtol does not take length as an input. Bufffer overflow/security issue possible.
+    return CARGS__parse_unsigned (input, 2, 'b', UINT64_MAX, (uint64_t*)out.address);
+}
 
-    errno              = 0; // To detect if strtol failed
-    *(int*)out.address = strtol (input, NULL, 10);
-    return errno != ERANGE;
+bool cargs_binary_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    uint64_t value = 0;
+    return CARGS__parse_unsigned (input, 2, 'b', UINT64_MAX, &value);
 }
 
 bool cargs_string_parse_string (struct Cargs_TypeInterface* self, const char* input,
@@ -651,6 +3449,20 @@ bool cargs_string_parse_string (struct Cargs_TypeInterface* self, const char* in
     return true;
 }
 
+bool cargs_string_view_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                     Cargs_Slice out)
+{
+    assert (self != NULL);
+    assert (self->CARGS__value != NULL);
+    assert (out.len == sizeof (Cargs_StringView));
+    CARGS_UNUSED (self);
+
+    // No copy is made, view points to the input (argv or the default value) and is not clamped to
+    // CARGS_MAX_INPUT_VALUE_LEN.
+    *(Cargs_StringView*)out.address = (Cargs_StringView){ .str = input, .len = strlen (input) };
+    return true;
+}
+
 bool cargs_flag_parse_string (struct Cargs_TypeInterface* self, const char* input, Cargs_Slice out)
 {
     assert (self != NULL);
@@ -672,6 +3484,186 @@ bool cargs_flag_parse_string (struct Cargs_TypeInterface* self, const char* inpu
     return true;
 }
 
+bool cargs_string_view_equals (struct Cargs_TypeInterface* self, const void* a, const void* b)
+{
+    CARGS_UNUSED (self);
+    const Cargs_StringView* view_a = (const Cargs_StringView*)a;
+    const Cargs_StringView* view_b = (const Cargs_StringView*)b;
+    return view_a->len == view_b->len && memcmp (view_a->str, view_b->str, view_a->len) == 0;
+}
+
+    #define CARGS__MAX_DOUBLE_LEN 512 // Longer tokens are not accepted as a decimal number
+
+// Compares ASCII strings, ignoring the case of the letters in input. name must be in lower case.
+static bool CARGS__equals_lower (const char* input, const char* name)
+{
+    for (; *name != '\0'; input++, name++) {
+        if ((*input | 0x20) != *name) {
+            return false;
+        }
+    }
+    return *input == '\0';
+}
+
+// Slow path, when the value cannot be calculated exactly with doubles. As the decimal point of
+// strtod is of the current locale, the token (already validated) is copied without its '.' and
+// with the exponent lowered by the number of fraction digits (1.25e3 as 125e1). Digits and the
+// exponent are read the same with every LC_NUMERIC, and the locale is never queried, which is not
+// thread safe (batch parsing workers convert values too).
+static bool CARGS__strtod (const char* input, double* out)
+{
+    char buffer[CARGS__MAX_DOUBLE_LEN + 24];
+    size_t buffer_len = 0;
+    int64_t exponent  = 0;
+    bool is_fraction  = false;
+    const char* cur   = input;
+    char* end         = NULL;
+
+    for (; *cur != '\0' && *cur != 'e' && *cur != 'E'; cur++) {
+        if (*cur == '.') {
+            is_fraction = true;
+        } else {
+            buffer[buffer_len++] = *cur;
+            exponent -= is_fraction;
+        }
+    }
+
+    if (*cur != '\0') {
+        bool is_exp_negative = false;
+        int64_t exp_value    = 0;
+
+        cur++;
+        if (*cur == '-' || *cur == '+') {
+            is_exp_negative = (*cur++ == '-');
+        }
+        for (; *cur != '\0'; cur++) {
+            exp_value = CARGS__MIN (exp_value * 10 + (*cur - '0'), 100000); // Beyond any double
+        }
+        exponent += is_exp_negative ? -exp_value : exp_value;
+    }
+
+    // Digits of the exponent are found from the last one, so are copied in reverse.
+    buffer[buffer_len++] = 'e';
+    if (exponent < 0) {
+        buffer[buffer_len++] = '-';
+        exponent             = -exponent;
+    }
+    char digits[8];
+    size_t digit_count = 0;
+    do {
+        digits[digit_count++] = (char)('0' + exponent % 10);
+        exponent /= 10;
+    } while (exponent != 0);
+    while (digit_count > 0) {
+        buffer[buffer_len++] = digits[--digit_count];
+    }
+    buffer[buffer_len] = '\0';
+
+    *out = strtod (buffer, &end);
+
+    // Values too small for a double become 0 or subnormal, which is fine. Too large ones are not.
+    return *end == '\0' && *out <= DBL_MAX && *out >= -DBL_MAX;
+}
+
+// Parses the full token, which must be a decimal number: optional sign, digits with an optional
+// '.' (at least one digit on either side) and an optional exponent. inf, infinity and nan are
+// accepted in any case. Unlike strtod, it does not depend on the locale.
+//
+// When the significant digits fit in 53 bits and the power of ten is at most 10^22, both are exact
+// doubles, so a single multiplication or division is correctly rounded (Clinger's fast path).
+// Which is the case for the most of the command line values. Rest go through strtod.
+static bool CARGS__parse_double (const char* input, double* out)
+{
+    static const double exact_powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    size_t len       = strnlen (input, CARGS__MAX_DOUBLE_LEN + 1);
+    const char* cur  = input;
+    bool is_negative = false;
+
+    if (len > CARGS__MAX_DOUBLE_LEN) {
+        return false;
+    }
+
+    if (*cur == '-' || *cur == '+') {
+        is_negative = (*cur++ == '-');
+    }
+
+    if (CARGS__equals_lower (cur, "inf") || CARGS__equals_lower (cur, "infinity")) {
+        *out = is_negative ? -__builtin_inf() : __builtin_inf();
+        return true;
+    }
+    if (CARGS__equals_lower (cur, "nan")) {
+        *out = is_negative ? -__builtin_nan ("") : __builtin_nan ("");
+        return true;
+    }
+
+    uint64_t mantissa = 0;     // First 19 significant digits, so it never overflows
+    int digit_count   = 0;     // Significant digits in mantissa
+    int64_t exponent  = 0;     // Power of ten of the mantissa
+    bool is_truncated = false; // true if non zero digits did not fit in the mantissa
+    bool has_digits   = false;
+
+    for (bool is_fraction = false;; cur++) {
+        if (*cur == '.' && !is_fraction) {
+            is_fraction = true;
+            continue;
+        }
+        if (*cur < '0' || *cur > '9') {
+            break;
+        }
+
+        has_digits = true;
+        if (digit_count < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*cur - '0');
+            digit_count += (mantissa != 0); // Leading zeros are not significant
+            exponent -= is_fraction;
+        } else {
+            is_truncated |= (*cur != '0');
+            exponent += !is_fraction;
+        }
+    }
+
+    if (!has_digits) {
+        return false;
+    }
+
+    if (*cur == 'e' || *cur == 'E') {
+        bool is_exp_negative = false;
+        int64_t exp_value    = 0;
+
+        cur++;
+        if (*cur == '-' || *cur == '+') {
+            is_exp_negative = (*cur++ == '-');
+        }
+        if (*cur < '0' || *cur > '9') {
+            return false;
+        }
+        for (; *cur >= '0' && *cur <= '9'; cur++) {
+            exp_value = CARGS__MIN (exp_value * 10 + (*cur - '0'), 100000); // Beyond any double
+        }
+        exponent += is_exp_negative ? -exp_value : exp_value;
+    }
+
+    if (*cur != '\0') {
+        return false;
+    }
+
+    #if FLT_EVAL_METHOD == 0 // Doubles are not evaluated in a wider precision (x87)
+    if (!is_truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value        = (exponent < 0) ? value / exact_powers_of_ten[-exponent]
+                                      : value * exact_powers_of_ten[exponent];
+        *out         = is_negative ? -value : value;
+        return true;
+    }
+    #endif // FLT_EVAL_METHOD
+
+    return CARGS__strtod (input, out);
+}
+
 bool cargs_double_parse_string (struct Cargs_TypeInterface* self, const char* input,
                                 Cargs_Slice out)
 {
@@ -680,12 +3672,20 @@ bool cargs_double_parse_string (struct Cargs_TypeInterface* self, const char* in
     assert (out.len == sizeof (double));
     CARGS_UNUSED (self);
 
-    // TODO: strtod does not take length as an input. Bufffer overflow/security issue possible
+    return CARGS__parse_double (input, (double*)out.address);
+}
 
-    errno = 0; // To detect if strtol failed
+bool cargs_double_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    double value = 0;
+    return CARGS__parse_double (input, &value);
+}
 
-    *(double*)out.address = strtod (input, NULL);
-    return errno != ERANGE;
+bool cargs_double_equals (struct Cargs_TypeInterface* self, const void* a, const void* b)
+{
+    CARGS_UNUSED (self);
+    return *(const double*)a == *(const double*)b; // 0.0 and -0.0 are equal
 }
 #endif // CARGS_IMPLEMENTATION
 
@@ -693,11 +3693,18 @@ bool cargs_double_parse_string (struct Cargs_TypeInterface* self, const char* in
  * Interface types
  *********************************************************************************************/
 
+#ifdef __cplusplus
+// C++ code uses the types of the C translation unit which has the implementation (the
+// implementation is C only).
+extern Cargs_TypeInterface Boolean, Integer, Int64, UInt64, Size, Hex, Octal, Binary, String,
+    StringView, Flag, Double, Help;
+#else
 Cargs_TypeInterface Boolean = {
     CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
     .type_size    = sizeof (bool),
     .format_help  = "(false|true)",
     .parse_string = cargs_bool_parse_string,
+    .check_string = cargs_bool_check_string,
 };
 
 Cargs_TypeInterface Integer = {
@@ -705,6 +3712,56 @@ Cargs_TypeInterface Integer = {
     .type_size    = sizeof (int),
     .format_help  = "(number)",
     .parse_string = cargs_int_parse_string,
+    .check_string = cargs_int_check_string,
+};
+
+Cargs_TypeInterface Int64 = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (int64_t),
+    .format_help  = "(number)",
+    .parse_string = cargs_int64_parse_string,
+    .check_string = cargs_int64_check_string,
+};
+
+Cargs_TypeInterface UInt64 = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (uint64_t),
+    .format_help  = "(unsigned number)",
+    .parse_string = cargs_uint64_parse_string,
+    .check_string = cargs_uint64_check_string,
+};
+
+Cargs_TypeInterface Size = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (size_t),
+    .format_help  = "(size)",
+    .parse_string = cargs_size_parse_string,
+    .check_string = cargs_size_check_string,
+};
+
+// Hex, Octal and Binary values are uint64_t. Prefix (0x, 0o, 0b) is optional.
+Cargs_TypeInterface Hex = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (uint64_t),
+    .format_help  = "(hex number)",
+    .parse_string = cargs_hex_parse_string,
+    .check_string = cargs_hex_check_string,
+};
+
+Cargs_TypeInterface Octal = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (uint64_t),
+    .format_help  = "(octal number)",
+    .parse_string = cargs_octal_parse_string,
+    .check_string = cargs_octal_check_string,
+};
+
+Cargs_TypeInterface Binary = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (uint64_t),
+    .format_help  = "(binary number)",
+    .parse_string = cargs_binary_parse_string,
+    .check_string = cargs_binary_check_string,
 };
 
 // +1 for the NULL byte which the CARGS_MAX_INPUT_VALUE_LEN does not include
@@ -716,6 +3773,14 @@ Cargs_TypeInterface String = {
     .parse_string = cargs_string_parse_string,
 };
 
+Cargs_TypeInterface StringView = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .type_size    = sizeof (Cargs_StringView),
+    .format_help  = "(text)",
+    .parse_string = cargs_string_view_parse_string,
+    .equals       = cargs_string_view_equals,
+};
+
 Cargs_TypeInterface Flag = {
     .CARGS__name    = "",
     .CARGS__is_flag = true,
@@ -729,6 +3794,8 @@ Cargs_TypeInterface Double = {
     .type_size    = sizeof (double),
     .format_help  = "(decimal number)",
     .parse_string = cargs_double_parse_string,
+    .equals       = cargs_double_equals,
+    .check_string = cargs_double_check_string,
 };
 
 Cargs_TypeInterface Help = {
@@ -738,3 +3805,55 @@ Cargs_TypeInterface Help = {
     .format_help    = "",
     .parse_string   = cargs_flag_parse_string,
 };
+#endif // __cplusplus
+
+#ifdef __cplusplus
+} // extern "C"
+
+    #if __has_include(<memory_resource>)
+        #include <memory_resource>
+
+// Adapter of a std::pmr::memory_resource (C++17), so cargs allocates from a pool resource, for
+// example. Exceptions thrown by the resource are reported to cargs as allocation failures.
+struct Cargs_PmrAllocator {
+    Cargs_Allocator allocator;
+    std::pmr::memory_resource* resource;
+};
+
+inline void* CARGS__pmr_reallocate (Cargs_Allocator* self, void* ptr, size_t old_size,
+                                    size_t new_size)
+{
+    std::pmr::memory_resource* resource = CARGS_PARENT_OF (self, Cargs_PmrAllocator,
+                                                           allocator)->resource;
+    void* new_ptr = NULL;
+    try {
+        new_ptr = resource->allocate (new_size, alignof (max_align_t));
+    } catch (...) {
+        return NULL;
+    }
+    if (ptr != NULL) {
+        memcpy (new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+        resource->deallocate (ptr, old_size, alignof (max_align_t));
+    }
+    return new_ptr;
+}
+
+inline void CARGS__pmr_deallocate (Cargs_Allocator* self, void* ptr, size_t size)
+{
+    CARGS_PARENT_OF (self, Cargs_PmrAllocator, allocator)
+        ->resource->deallocate (ptr, size, alignof (max_align_t));
+}
+
+// Returns the allocator, which is &pmr->allocator. resource must outlive the parsers using it. It
+// is not taken as thread safe, is_thread_safe can be set if resource is (a synchronized pool).
+inline Cargs_Allocator* cargs_pmr_allocator_init (Cargs_PmrAllocator* pmr,
+                                                  std::pmr::memory_resource* resource)
+{
+    pmr->allocator.reallocate     = CARGS__pmr_reallocate;
+    pmr->allocator.deallocate     = CARGS__pmr_deallocate;
+    pmr->allocator.is_thread_safe = false;
+    pmr->resource                 = resource;
+    return &pmr->allocator;
+}
+    #endif // __has_include(<memory_resource>)
+#endif     // __cplusplus
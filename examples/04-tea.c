@@ -22,16 +22,6 @@ typedef struct {
 
 Config config = { 0 };
 
-static bool stdout_print_enable (void)
-{
-    return *config.do_encrypt == false;
-}
-
-static bool key_as_param_enable (void)
-{
-    return *config.key_from_stdin == false;
-}
-
 static bool post_delete_enable (void)
 {
     return *config.output_to_stdout == false;
@@ -48,11 +38,11 @@ int main (int argc, char** argv)
 
     config.key_from_stdin = cargs_add_arg ("K", "16 byte key (from stdin)", Flag, "false");
 
-    config.infiles = cargs_add_arg ("I", "Files that need to be processed", CARGS_LISTOF (String),
-                                    NULL);
+    config.infiles = cargs_add_arg ("I", "Files that need to be processed",
+                                    CARGS_LISTOF (StringView), NULL);
 
-    config.output_to_stdout = cargs_add_cond_arg_d (stdout_print_enable, "When -e is false", "N",
-                                                    "Display output to stdout", Flag, "false");
+    config.output_to_stdout = cargs_add_when_arg ("e", "false", "N", "Display output to stdout",
+                                                  Flag, "false");
 
     config.post_delete_enabled =
         cargs_add_cond_arg_d (post_delete_enable, "When -N is false", "D",
@@ -63,8 +53,7 @@ int main (int argc, char** argv)
 
     config.display_help = cargs_add_arg ("h", "Display this help message", Help, "false");
 
-    config.key = cargs_add_cond_arg_d (key_as_param_enable, "When -K is false", "k",
-                                       "16 byte key (as argument)", String, NULL);
+    config.key = cargs_add_when_arg ("K", "false", "k", "16 byte key (as argument)", String, NULL);
 
     if (!cargs_parse_input (argc, argv)) {
         USAGE (argv[0]);
@@ -89,7 +78,7 @@ int main (int argc, char** argv)
     printf ("Number of input files: %ld\n", config.infiles->len);
 
     for (unsigned i = 0; i < config.infiles->len; i++) {
-        printf ("* %s\n", ((Cargs_StringType*)config.infiles->buffer)[i]);
+        printf ("* %s\n", ((Cargs_StringView*)config.infiles->buffer)[i].str);
     }
 
     cargs_cleanup();
@@ -0,0 +1,30 @@
+// cargs is compiled as C, in its own translation unit (with CARGS_IMPLEMENTATION defined), and its
+// memory comes from a C++ pool resource.
+#include <cstdio>
+#include <memory_resource>
+#include "../cargs.h"
+
+int main (int argc, char** argv)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    Cargs_PmrAllocator allocator;
+    cargs_use_allocator (cargs_pmr_allocator_init (&allocator, &pool));
+
+    int* count             = (int*)cargs_add_arg ("n", "Number of items", Integer, "1");
+    Cargs_ArrayList* files = (Cargs_ArrayList*)cargs_add_arg ("I", "Input files",
+                                                              CARGS_LISTOF (String), NULL);
+    bool* show_help        = (bool*)cargs_add_arg ("h", "Show usage", Help, "false");
+
+    if (!cargs_parse_input (argc, argv) || *show_help) {
+        cargs_print_help();
+        cargs_cleanup();
+        return *show_help ? 0 : 1;
+    }
+
+    printf ("count: %d\n", *count);
+    for (size_t i = 0; i < files->len; i++) {
+        printf ("file: %s\n", (char*)files->buffer + i * files->item_size);
+    }
+    cargs_cleanup();
+    return 0;
+}
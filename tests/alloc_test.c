@@ -0,0 +1,440 @@
+#include <stdbool.h>
+#define YUKTI_TEST_STRIP_PREFIX
+#define YUKTI_TEST_IMPLEMENTATION
+#include "yukti.h"
+
+#define CARGS_IMPLEMENTATION
+#include "../cargs.h"
+
+/**************************************************************************************************
+ * Exact number of allocations and peak heap bytes of cargs, for representative schemas. malloc,
+ * calloc, realloc and free are wrapped by the linker (-Wl,--wrap=...), so every call made by cargs
+ * is seen. Allocations are tracked only between alloc_start and alloc_stop, so the ones made by the
+ * test framework are left out; blocks allocated while tracking are tracked till they are freed.
+ **************************************************************************************************/
+
+#define ARRAY_LEN(a) (sizeof (a) / sizeof (a[0]))
+
+// Bytes of the name trie, while it has at most CARGS__INITIAL_TRIE_CAPACITY nodes
+#define INITIAL_TRIE_SIZE (CARGS__INITIAL_TRIE_CAPACITY * sizeof (CARGS__TrieNode))
+
+// Mocked implementations -----------------------------------------------------------------
+#ifndef CARGS_UNITTEST
+    #error "CARGS_UNITTEST must be defined"
+#endif // CARGS_UNITTEST
+
+YT_DECLARE_FUNC_VOID (cargs_panic, const char*);
+YT_DEFINE_FUNC_VOID (cargs_panic, const char*);
+
+// Allocator wrappers -----------------------------------------------------------------------------
+void* __real_malloc (size_t size);
+void* __real_calloc (size_t count, size_t size);
+void* __real_realloc (void* ptr, size_t size);
+void __real_free (void* ptr);
+
+typedef struct {
+    size_t alloc_count;   // New blocks (malloc, calloc and realloc of NULL)
+    size_t realloc_count; // Blocks resized
+    size_t free_count;
+    size_t live_bytes;
+    size_t peak_bytes;
+} AllocStats;
+
+static AllocStats stats;
+static bool is_tracking = false;
+static struct {
+    void* ptr;
+    size_t size;
+} blocks[256]; // Live blocks allocated while tracking
+
+static void track (void* ptr, size_t size)
+{
+    for (size_t i = 0; i < ARRAY_LEN (blocks); i++) {
+        if (blocks[i].ptr == NULL) {
+            blocks[i].ptr  = ptr;
+            blocks[i].size = size;
+            stats.live_bytes += size;
+            stats.peak_bytes = CARGS__MAX (stats.peak_bytes, stats.live_bytes);
+            return;
+        }
+    }
+    abort(); // Test schemas are small, blocks is never expected to be full.
+}
+
+static bool untrack (void* ptr, size_t* size)
+{
+    for (size_t i = 0; ptr != NULL && i < ARRAY_LEN (blocks); i++) {
+        if (blocks[i].ptr == ptr) {
+            *size         = blocks[i].size;
+            blocks[i].ptr = NULL;
+            stats.live_bytes -= *size;
+            return true;
+        }
+    }
+    return false;
+}
+
+void* __wrap_malloc (size_t size)
+{
+    void* ptr = __real_malloc (size);
+    if (ptr != NULL && is_tracking) {
+        stats.alloc_count++;
+        track (ptr, size);
+    }
+    return ptr;
+}
+
+void* __wrap_calloc (size_t count, size_t size)
+{
+    void* ptr = __real_calloc (count, size);
+    if (ptr != NULL && is_tracking) {
+        stats.alloc_count++;
+        track (ptr, count * size);
+    }
+    return ptr;
+}
+
+void* __wrap_realloc (void* ptr, size_t size)
+{
+    size_t old_size  = 0;
+    bool was_tracked = untrack (ptr, &old_size);
+    void* new_ptr    = __real_realloc (ptr, size);
+
+    if (new_ptr == NULL) {
+        if (was_tracked) {
+            track (ptr, old_size); // Old block is still there
+        }
+    } else if (is_tracking || was_tracked) {
+        if (ptr == NULL) {
+            stats.alloc_count++;
+        } else {
+            stats.realloc_count++;
+        }
+        track (new_ptr, size);
+    }
+    return new_ptr;
+}
+
+void __wrap_free (void* ptr)
+{
+    size_t size = 0;
+    if (untrack (ptr, &size)) {
+        stats.free_count++;
+    }
+    __real_free (ptr);
+}
+
+static void alloc_start (void)
+{
+    stats       = (AllocStats){ .live_bytes = stats.live_bytes, .peak_bytes = stats.live_bytes };
+    is_tracking = true;
+}
+
+static void alloc_stop (void)
+{
+    is_tracking = false;
+}
+// ------------------------------------------------------------------------------------------------
+
+static bool always_true (void)
+{
+    return true;
+}
+
+TEST (alloc, scalar_arguments)
+{
+    // One allocation for the argument registry, one for the name trie and one for each argument,
+    // which has its value in it.
+    alloc_start();
+    cargs_add_arg ("n", "Count", Integer, "1");
+    cargs_add_arg ("s", "Name", String, NULL);
+    cargs_add_arg ("f", "Force", Flag, "false");
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 5U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    EQ_SCALAR (stats.peak_bytes, CARGS__REGISTRY_SIZE (CARGS__INITIAL_ARG_CAPACITY) +
+                                     INITIAL_TRIE_SIZE + 3 * CARGS__ARG_VALUE_OFFSET +
+                                     sizeof (int) + sizeof (Cargs_StringType) + sizeof (bool));
+
+    // Parsing scalar values allocates nothing.
+    char* argv[] = { "dummy", "-n", "2", "-s", "name", "-f", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 0U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+
+    alloc_start();
+    cargs_cleanup();
+    alloc_stop();
+
+    EQ_SCALAR (stats.free_count, 5U);
+    EQ_SCALAR (stats.live_bytes, 0U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+TEST (alloc, registry_growth)
+{
+    // Registry doubles as it fills up, so 100 arguments need 4 registries (16, 32, 64 and 128
+    // arguments). Each one is freed once the arguments are moved to the next. Names need 103 trie
+    // nodes (root, '-', 'a', 10 first and 90 second digits), so the trie is resized once.
+    char names[100][8];
+    alloc_start();
+    for (unsigned i = 0; i < ARRAY_LEN (names); i++) {
+        snprintf (names[i], sizeof (names[i]), CARGS__ARGUMENT_PREFIX_CHAR "a%u", i);
+        CARGS__cargs_add_arg (names[i], "Count", Integer, "1", NULL, NULL);
+    }
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 105U);
+    EQ_SCALAR (stats.realloc_count, 1U);
+    EQ_SCALAR (stats.free_count, 3U);
+    EQ_SCALAR (stats.live_bytes, CARGS__REGISTRY_SIZE (128) + 2 * INITIAL_TRIE_SIZE +
+                                     100 * (CARGS__ARG_VALUE_OFFSET + sizeof (int)));
+    EQ_SCALAR (*(int*)cargs_get ("a99"), 1);
+
+    alloc_start();
+    cargs_cleanup();
+    alloc_stop();
+
+    EQ_SCALAR (stats.free_count, 102U);
+    EQ_SCALAR (stats.live_bytes, 0U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+TEST (alloc, list_growth)
+{
+    // Argument, with its list in it. Default value is in the inline buffer of the list.
+    alloc_start();
+    cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), "1");
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 3U);
+    EQ_SCALAR (stats.peak_bytes, CARGS__REGISTRY_SIZE (CARGS__INITIAL_ARG_CAPACITY) +
+                                     INITIAL_TRIE_SIZE + CARGS__ARG_VALUE_OFFSET +
+                                     sizeof (Cargs_ArrayList));
+
+    // Values move out of the inline buffer once, to a buffer of the exact number of values counted
+    // in the command line.
+    char* argv[] = { "dummy", "-v", "1",  "2",  "3",  "4",  "5",  "6",  "7",  "8",  "9",
+                     "10",    "11", "12", "13", "14", "15", "16", "17", "18", "19", "20",
+                     "21",    "22", "23", "24", "25", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 1U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    EQ_SCALAR (stats.live_bytes, CARGS__REGISTRY_SIZE (CARGS__INITIAL_ARG_CAPACITY) +
+                                     INITIAL_TRIE_SIZE + CARGS__ARG_VALUE_OFFSET +
+                                     sizeof (Cargs_ArrayList) + 25 * sizeof (int));
+
+    alloc_start();
+    cargs_cleanup();
+    alloc_stop();
+
+    EQ_SCALAR (stats.free_count, 4U);
+    EQ_SCALAR (stats.live_bytes, 0U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+TEST (alloc, small_list)
+{
+    cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), "1");
+
+    // A few values stay in the inline buffer of the list.
+    char* argv[] = { "dummy", "-v", "1", "2", "3", "4", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    Cargs_ArrayList* list = cargs_get ("v");
+    EQ_SCALAR (stats.alloc_count, 0U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    EQ_SCALAR (list->len, 4U);
+    EQ_SCALAR (((int*)list->buffer)[3], 4);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+TEST (alloc, delimited_list_growth)
+{
+    cargs_add_arg ("w", "Weights", CARGS_LISTOF_DELIMITED (Integer, ","), NULL);
+
+    // 24 values, given 3 at a time, are also counted before parsing.
+    char* argv[] = { "dummy",    "-w", "1,2,3",    "-w", "4,5,6",    "-w", "7,8,9",    "-w",
+                     "10,11,12", "-w", "13,14,15", "-w", "16,17,18", "-w", "19,20,21", "-w",
+                     "22,23,24", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 1U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    EQ_SCALAR (((Cargs_ArrayList*)cargs_get ("w"))->capacity, 24U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+TEST (alloc, when_condition)
+{
+    cargs_add_arg ("m", "Mode", String, "slow");
+    cargs_add_when_arg ("m", "fast", "l", "Level", Integer, "1");
+    cargs_add_cond_arg (always_true, "c", "Color", Boolean, "false");
+
+    // Value of the 'when' condition is parsed once, on its first evaluation. Predicate conditions
+    // need no allocation.
+    char* argv[] = { "dummy", "-m", "fast", "-l", "2", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    EQ_SCALAR (cargs_is_enabled ("l"), true);
+    cargs_print_help();
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 1U);
+    EQ_SCALAR (stats.peak_bytes, sizeof (Cargs_StringType));
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+#define STATIC_ARGS(ARG, LIST)                            \
+    ARG (count, "n", "Count", Integer, int, 1, "1")       \
+    ARG (force, "f", "Force", Flag, bool, false, "false") \
+    LIST (values, "v", "Values", Integer)
+
+CARGS_STATIC_SCHEMA (static_args, STATIC_ARGS)
+
+TEST (alloc, static_schema)
+{
+    // Arguments, their values, the registry and the trie are all in static storage.
+    alloc_start();
+    cargs_add_static_schema (static_args);
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 0U);
+
+    // A few list values stay in the inline buffer of the list.
+    char* argv[] = { "dummy", "-n", "2", "-f", "-v", "1", "2", NULL };
+    alloc_start();
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 0U);
+    EQ_SCALAR (static_args.count, 2);
+
+    // Registry has room for 4 arguments and the trie for 10 nodes (5 are used by the schema), so
+    // the 2nd argument added moves both out of the static storage, which is not freed.
+    alloc_start();
+    cargs_add_arg ("x", "Extra", Integer, "0");
+    cargs_add_arg ("long", "Long", Integer, "0");
+    alloc_stop();
+
+    EQ_SCALAR (stats.alloc_count, 4U);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    EQ_SCALAR (stats.free_count, 0U);
+    EQ_SCALAR (stats.live_bytes, CARGS__REGISTRY_SIZE (8) + 20 * sizeof (CARGS__TrieNode) +
+                                     2 * (CARGS__ARG_VALUE_OFFSET + sizeof (int)));
+    EQ_SCALAR (*(int*)cargs_get ("n"), 2);
+    EQ_SCALAR (*(int*)cargs_get ("long"), 0);
+
+    alloc_start();
+    cargs_cleanup();
+    alloc_stop();
+
+    EQ_SCALAR (stats.free_count, 4U);
+    EQ_SCALAR (stats.live_bytes, 0U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+typedef enum {
+    TEST_ARENA_NONE,
+    TEST_ARENA_USER_SUPPLIED,
+    TEST_ARENA_LIBRARY_OWNED,
+} TEST_ARENA_MODE;
+
+TESTP (alloc, arena, TEST_ARENA_MODE, size_t)
+{
+    TEST_ARENA_MODE mode        = ARG_0();
+    size_t expected_alloc_count = ARG_1();
+
+    static unsigned char buffer[4096];
+    alloc_start();
+    if (mode == TEST_ARENA_USER_SUPPLIED) {
+        cargs_use_arena (buffer, sizeof (buffer));
+    } else if (mode == TEST_ARENA_LIBRARY_OWNED) {
+        cargs_use_arena (NULL, sizeof (buffer));
+    }
+
+    char* a            = cargs_add_arg ("A", "1st arg", String, NULL);
+    int* b             = cargs_add_arg ("B", "2nd arg", Integer, "13");
+    Cargs_ArrayList* c = cargs_add_arg ("C", "3rd arg", CARGS_LISTOF (Integer), NULL);
+
+    // Grows the list beyond its inline buffer.
+    char* argv[] = { "dummy", "-A", "abc", "-C", "1", "2", "3", "4", "5", "6",
+                     "7",     "8",  "9",   "10", "11", "12", NULL };
+    EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), true);
+    alloc_stop();
+
+    EQ_STRING (a, "abc");
+    EQ_SCALAR (*b, 13);
+    EQ_SCALAR (c->len, 12U);
+    EQ_SCALAR (((int*)c->buffer)[11], 12);
+
+    EQ_SCALAR (stats.alloc_count, expected_alloc_count);
+    EQ_SCALAR (stats.realloc_count, 0U);
+    if (mode == TEST_ARENA_LIBRARY_OWNED) {
+        EQ_SCALAR (stats.peak_bytes, sizeof (buffer));
+    }
+
+    // Cleanup releases everything allocated, including the arena owned by cargs.
+    alloc_start();
+    cargs_cleanup();
+    alloc_stop();
+
+    EQ_SCALAR (stats.free_count, expected_alloc_count);
+    EQ_SCALAR (stats.live_bytes, 0U);
+
+    MUST_NEVER_CALL (cargs_panic, _);
+    END();
+}
+
+void yt_reset()
+{
+    cargs_cleanup();
+    RESET_MOCK (cargs_panic);
+}
+
+int main (void)
+{
+    YT_INIT();
+    scalar_arguments();
+    registry_growth();
+    list_growth();
+    small_list();
+    delimited_list_growth();
+    when_condition();
+    static_schema();
+    // arena:
+    // Case 1: No arena. 1 for the argument registry + 1 for the name trie + 1 for each arg (value
+    //         is in it) + 1 buffer for the list values, which do not fit in the list.
+    // Case 2: Caller supplied arena. No heap allocation.
+    // Case 3: Arena allocated by cargs. Only the arena itself.
+    arena (3,
+           ARG (TEST_ARENA_MODE){ TEST_ARENA_NONE, TEST_ARENA_USER_SUPPLIED,
+                                  TEST_ARENA_LIBRARY_OWNED },
+           ARG (size_t){ 6, 0, 1 });
+    YT_RETURN_WITH_REPORT();
+}
@@ -18,7 +18,7 @@ YT_DEFINE_FUNC_VOID (cargs_panic, const char*);
 
 TEST (arl, new_with_capacity)
 {
-    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (10, sizeof (int));
+    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (NULL, 10, sizeof (int));
     NEQ_SCALAR (nl, NULL);
     NEQ_SCALAR (nl->buffer, NULL);
     EQ_SCALAR (nl->capacity, 10U);
@@ -31,7 +31,7 @@ TEST (arl, new_with_capacity)
 
 TEST (arl, push_pop_within_capacity)
 {
-    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (2, sizeof (char) * 2);
+    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (NULL, 2, sizeof (char) * 2);
 
     NEQ_SCALAR (CARGS__arl_push (nl, "a"), NULL);
     NEQ_SCALAR (CARGS__arl_push (nl, "b"), NULL);
@@ -50,7 +50,7 @@ TEST (arl, push_pop_within_capacity)
 
 TEST (arl, push_pop_beyond_capacity)
 {
-    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (2, sizeof (char) * 2);
+    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (NULL, 2, sizeof (char) * 2);
 
     NEQ_SCALAR (CARGS__arl_push (nl, "a"), NULL);
     NEQ_SCALAR (CARGS__arl_push (nl, "b"), NULL);
@@ -79,7 +79,7 @@ TEST (arl, push_pop_beyond_capacity)
 
 TEST (arl, contigous_items)
 {
-    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (5, sizeof (char));
+    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (NULL, 5, sizeof (char));
 
     char a = 'a', b = 'b', c = 'c';
     NEQ_SCALAR (CARGS__arl_push (nl, &a), NULL);
@@ -97,6 +97,54 @@ TEST (arl, contigous_items)
     END();
 }
 
+TEST (arl, reserve)
+{
+    Cargs_ArrayList* nl = CARGS__arl_new_with_capacity (NULL, 2, sizeof (char));
+
+    char a = 'a';
+    NEQ_SCALAR (CARGS__arl_push (nl, &a), NULL);
+
+    CARGS__arl_reserve (nl, 1); // Does not shrink
+    EQ_SCALAR (nl->capacity, 2U);
+
+    CARGS__arl_reserve (nl, 100);
+    EQ_SCALAR (nl->capacity, 100U);
+    EQ_SCALAR (nl->len, 1U);
+    EQ_SCALAR (((char*)nl->buffer)[0], 'a');
+
+    // REQUIRED to keep memory sanitizer happy
+    CARGS__arl_dealloc(nl);
+    END();
+}
+
+TEST (arl, inline_buffer)
+{
+    Cargs_ArrayList list;
+    CARGS__arl_init (&list, NULL, sizeof (int));
+    EQ_SCALAR (list.capacity, CARGS__ARL_INLINE_SIZE / sizeof (int));
+    EQ_SCALAR (list.buffer, (void*)list.CARGS__inline.CARGS__bytes);
+
+    // Items are moved out of the inline buffer when it is full.
+    int count = (int)list.capacity + 1;
+    for (int i = 0; i < count; i++) {
+        NEQ_SCALAR (CARGS__arl_push (&list, &i), NULL);
+    }
+    NEQ_SCALAR (list.buffer, (void*)list.CARGS__inline.CARGS__bytes);
+    EQ_SCALAR (list.len, (size_t)count);
+    EQ_SCALAR (((int*)list.buffer)[0], 0);
+    EQ_SCALAR (((int*)list.buffer)[list.len - 1], (int)list.len - 1);
+
+    // Items larger than the inline buffer are never kept in it.
+    Cargs_ArrayList large_list;
+    CARGS__arl_init (&large_list, NULL, CARGS__ARL_INLINE_SIZE + 1);
+    EQ_SCALAR (large_list.capacity, 0U);
+    EQ_SCALAR (large_list.buffer, NULL);
+
+    // REQUIRED to keep memory sanitizer happy
+    CARGS__arl_free_buffer (&list);
+    END();
+}
+
 void yt_reset()
 {
 }
@@ -108,5 +156,7 @@ int main (void)
     push_pop_within_capacity();
     push_pop_beyond_capacity();
     contigous_items();
+    reserve();
+    inline_buffer();
     YT_RETURN_WITH_REPORT();
 }
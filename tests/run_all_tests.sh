@@ -6,7 +6,8 @@ if [ $DIRNAME = "." ]; then
     ROOT_PATH=".."
 fi
 OUTFILE=$ROOT_PATH/tests/test
-SAN_OPTS="address,null,pointer-overflow,object-size,return,unreachable,bounds"
+SAN_OPTS="address,null,pointer-overflow,object-size,return,unreachable,bounds,alignment"
+ALLOC_WRAP_OPTS="-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free"
 
 #===============================================================================
 # Build examples
@@ -25,6 +26,20 @@ for cfile in ${EXAMPLES_SRC[@]}; do
     gcc -Wall -Wextra $cfile -o $OUTFILE || exit
 done
 
+# C++ examples link with the implementation compiled as C.
+CPP_EXAMPLES_SRC=(
+    "$ROOT_PATH/examples/05-pmr-allocator.cpp"
+)
+
+printf '#define CARGS_IMPLEMENTATION\n#include "cargs.h"\n' |
+    gcc -Wall -Wextra -x c -I$ROOT_PATH -c - -o $OUTFILE.o || exit
+
+for cppfile in ${CPP_EXAMPLES_SRC[@]}; do
+    echo "Compiling '$cppfile'.."
+    g++ -std=c++17 -Wall -Wextra $cppfile $OUTFILE.o -o $OUTFILE || exit
+done
+rm -f $OUTFILE.o
+
 #===============================================================================
 # Build and run tests
 #===============================================================================
@@ -33,14 +48,22 @@ echo "[2/2] Compiling and running tests.."
 TEST_SRC=(
     "$ROOT_PATH/tests/test.c"
     "$ROOT_PATH/tests/arraylist_test.c"
+    "$ROOT_PATH/tests/alloc_test.c"
 )
 
 for cfile in ${TEST_SRC[@]}; do
+    # Allocation test counts the allocations through the wrapped allocator functions.
+    LINK_OPTS=""
+    if [ $(basename $cfile) = "alloc_test.c" ]; then
+        LINK_OPTS=$ALLOC_WRAP_OPTS
+    fi
+
     echo "Compiling '$cfile'.."
     gcc -g                             \
         -Wall -Wextra                  \
         -fsanitize=$SAN_OPTS $cfile    \
-        -DCARGS_UNITTEST               \
+        -DCARGS_UNITTEST -pthread      \
+        $LINK_OPTS                     \
         -o $OUTFILE || exit
 
     ./$OUTFILE || exit
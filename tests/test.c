@@ -1,10 +1,14 @@
+#include <locale.h>
 #include <stdbool.h>
+#include <unistd.h>
 #define YUKTI_TEST_IMPLEMENTATION
 #include "yukti.h"
 
 #define CARGS_MAX_INPUT_VALUE_LEN_OVERRIDE 10 // A small enough number for easy testing
 #define CARGS_MAX_NAME_LEN_OVERRIDE        CARGS_MAX_INPUT_VALUE_LEN_OVERRIDE
 #define CARGS_MAX_DESCRIPTION_LEN_OVERRIDE CARGS_MAX_INPUT_VALUE_LEN_OVERRIDE
+#define CARGS_ENABLE_BATCH_PARSE
+#define CARGS_ENABLE_STATS
 #define CARGS_IMPLEMENTATION
 #include "../cargs.h"
 
@@ -21,6 +25,29 @@
  *  - [REQ: 17] Providing List arg values in one go or multiple should have same result.
  *  - [REQ: 18] Providing a value to optional args must override its default value.
  *  - [REQ: 21] Providing duplicate single valued arguments are not allowed.
+ *  - [REQ: 28] Stream arg values are passed to the callback in order, as they are parsed.
+ *  - [REQ: 29] Stream arg default value is passed to the callback, if no value was provided.
+ *  - [REQ: 30] Fail if stream callback does not accept a value.
+ *  - [REQ: 37] Values of delimited list arg are split by any of the delimiters.
+ *  - [REQ: 38] A 'when' arg is active if its condition arg is active and has the condition value.
+ *  - [REQ: 39] Condition of an arg is evaluated only once.
+ *  - [REQ: 41] Fail if more than one arg of a mutex group is given.
+ *  - [REQ: 42] Fail if only some of the args of a together group are given.
+ *  - [REQ: 43] Fail if none of the args of an at least one group is given.
+ *  - [REQ: 64] Any number of groups can be added.
+ *  - [REQ: 27] Tokens in '@file' response files are parsed as if they were in the command line.
+ *  - [REQ: 65] '@@text' is the token '@text'. With response files turned off, '@text' is itself.
+ *  - [REQ: 50] A name which is the prefix of only one argument name is that argument. A full name
+ *              is used even if it is also the prefix of other names.
+ *  - [REQ: 51] Fail if a name is the prefix of more than one argument name.
+ *  - [REQ: 52] Unknown name is suggested the closest argument name, if it is close enough.
+ *  - [REQ: 54] --name is same as -name, and a value can be given with the name as name=value.
+ *  - [REQ: 55] One char flag names can be given together (-abc), the last one can take a value.
+ *  - [REQ: 56] A token starting with CARGS__ARGUMENT_PREFIX_CHAR, which is not a name, is a value
+ *              of the current argument if it is a negative number and the argument takes values,
+ *              or if check_string of its type (of a list too) accepts it.
+ * cargs_complete
+ *  - [REQ: 53] Names starting with a prefix are listed in sorted order, and all are counted.
  * cargs_add_arg
  *  - [REQ: 10] For list arg, multiple values of any number can be accessed by the pointer.
  *  - [REQ: 11] For non-list arg, value can be accessed by the pointer.
@@ -28,8 +55,51 @@
  *  - [REQ: 15] For optional args, the default value is accessed by the pointer if no arg was given.
  *  - [REQ: 16] Ability to use custom argument interface type.
  *  - [REQ: 20] Adding duplicate arguments are not allowed
+ *  - [REQ: 40] Adding 'when' arguments whose conditions form a cycle is not allowed.
+ * CARGS_LAZY
+ *  - [REQ: 44] Lazy arg value is converted only on first access, and only once.
+ *  - [REQ: 45] Invalid lazy arg value is reported while parsing if the type can check it,
+ *              otherwise on access.
+ *  - [REQ: 61] Built-in number and boolean types check lazy arg values while parsing, with the same
+ *              rules as their conversion.
+ * cargs_get_stats
+ *  - [REQ: 46] Conversions are counted by type, and every phase is timed.
+ * cargs_format_help
+ *  - [REQ: 47] Help message is written into the buffer and cut short, null terminated, if it does
+ *              not fit. Length of the whole message is returned.
+ * cargs_use_allocator
+ *  - [REQ: 48] Every allocation and release of a parser goes through its allocator (or the default
+ *              one), and blocks are released with the size they were allocated with.
+ *  - [REQ: 49] Bump allocator hands out blocks from the given buffer.
+ * cargs_add_static_schema
+ *  - [REQ: 23] Values of static schema arguments are accessed through the schema struct.
+ *  - [REQ: 24] Defaults of static schema arguments are available without parsing.
+ *  - [REQ: 58] Values of static schema arguments are reset to the defaults when it is added again.
+ *  - [REQ: 59] Static schema cannot be added to another parser before its parser is cleaned up.
+ *  - [REQ: 63] Static schema whose C type of an argument is not of the size of its interface
+ *              cannot be added.
+ * cargs_use_arena
+ *  - [REQ: 60] Blocks from a buffer (of an arena or a bump allocator) are aligned for any type,
+ *              even if the buffer is not.
+ * cargs_cleanup
+ *  - [REQ: 22] Arguments can be added again, with the same names, after cleanup.
+ * cargs_parser_*
+ *  - [REQ: 31] Arguments of independent parsers, even with same names, do not affect each other.
+ *  - [REQ: 32] Frozen parser can only be used as schema for batch parsing.
+ * cargs_parse_batch
+ *  - [REQ: 33] Each job is parsed independently, as if it was parsed alone with the schema.
+ *  - [REQ: 34] Status of each job is reported, failing jobs do not affect other jobs.
+ *  - [REQ: 57] Groups are checked in jobs as in the schema, even if arguments were added after
+ *              them.
+ *  - [REQ: 62] Workers allocate through the allocator of the schema, one at a time if it is not
+ *              thread safe.
+ * Interfaces
+ *  - [REQ: 35] Integer values must be fully made of digits (optional sign & base prefix) and must
+ *              fit in the type of the value.
+ *  - [REQ: 36] Double values must be decimal numbers, correctly rounded, regardless of the locale.
  * General
  *  - [REQ: 12] All string inputs must have some cap on its length when accessing.
+ *  - [REQ: 26] StringView values point into the input and are not capped in length.
  *
  * |-------------------|----------------------------------------------|---------------------------|
  * | FUT               | Requirement/Test case                        | Test function name        |
@@ -125,6 +195,275 @@
  * |                   | non list arguments in the command line.      |                           |
  * |                   | Parsing should fail.                         |                           |
  * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_cleanup,    | * [REQ: 22], [REQ: 20]                       |readd_args_after_cleanup   |
+ * | cargs_add_arg     |                                              |                           |
+ * |                   | Same arguments are added after cleanup. Must |                           |
+ * |                   | not be reported as duplicates.               |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_static_ | * [REQ: 23], [REQ: 24], [REQ: 5], [REQ: 18]  |static_schema              |
+ * | schema,           |                                              |                           |
+ * | cargs_parse_input | Static schema with optional, required & list |                           |
+ * |                   | args. Parsing should pass and results match  |                           |
+ * |                   | with input and defaults.                     |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_static_ | * [REQ: 58], [REQ: 59]                       |static_schema_reuse        |
+ * | schema,           |                                              |                           |
+ * | cargs_cleanup     | Static schema is parsed, cleaned up, added & |                           |
+ * |                   | parsed again without the values. Defaults    |                           |
+ * |                   | should be restored. Adding it to another     |                           |
+ * |                   | parser while it is in use should fail.       |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_static_ | * [REQ: 63]                                  |static_schema_type_mismatch|
+ * | schema            |                                              |                           |
+ * |                   | Double argument is declared as int. Adding   |                           |
+ * |                   | the schema should fail, nothing is added.    |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_arg,    | * [REQ: 26], [REQ: 10], [REQ: 15]            |string_view_argument       |
+ * | cargs_parse_input |                                              |                           |
+ * |                   | Values longer than CARGS_MAX_INPUT_VALUE_LEN |                           |
+ * |                   | given to StringView args. Parsing should pass|                           |
+ * |                   | and values must point into argv.             |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 27], [REQ: 10], [REQ: 11], [REQ: 26] |response_file              |
+ * |                   |                                              |                           |
+ * |                   | Arguments and values are given in a response |                           |
+ * |                   | file. Parsing should pass.                   |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | New line delimited tokens, with quoting.     | Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Null byte delimited tokens.                  | Test# 2                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_arg,    | * [REQ: 28], [REQ: 29], [REQ: 30], [REQ: 17] |stream_type_argument       |
+ * | CARGS_STREAMOF,   |----------------------------------------------|---------------------------|
+ * | cargs_parse_input | Values given to the stream arg, at once and  | Test# 1                   |
+ * |                   | individually. Parsing should pass.           |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | No values given. Parsing should pass and     | Test# 2                   |
+ * |                   | default value is passed to callback.         |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Callback rejects a value. Parsing should fail| Test# 3                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 27]                                  |response_file_missing      |
+ * |                   |                                              |                           |
+ * |                   | Response file does not exist.                |                           |
+ * |                   | Parsing should fail.                         |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_use_respons | * [REQ: 65]                                  |response_file_escape       |
+ * | e_files,          |                                              |                           |
+ * | cargs_parse_input | Values starting with '@' are given to String |                           |
+ * |                   | -A and StringView list -B. Parsing should    |                           |
+ * |                   | pass.                                        |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Response files on, '@' is escaped as '@@'.   | Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Response files off, '@' is not escaped.      | Test# 2                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parser_add_ | * [REQ: 31], [REQ: 11], [REQ: 10]            |independent_parsers        |
+ * | arg,              |                                              |                           |
+ * | cargs_parser_parse| Two parsers with the same argument names are |                           |
+ * | _input            | used one after another. Parsing should pass  |                           |
+ * |                   | and each parser has its own values.          |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parser_     | * [REQ: 32], [REQ: 33], [REQ: 34], [REQ: 15] |batch_parsing              |
+ * | freeze,           |                                              |                           |
+ * | cargs_parse_batch | Many jobs (one of them invalid) are parsed   |                           |
+ * |                   | on multiple threads with a frozen schema.    |                           |
+ * |                   | Results of each job match its input.         |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_batch | * [REQ: 57], [REQ: 41]                       |batch_group_before_args    |
+ * |                   |                                              |                           |
+ * |                   | Mutex group is added before most of the      |                           |
+ * |                   | arguments of the schema. Only the job which  |                           |
+ * |                   | gives both of its arguments should fail.     |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_batch,| * [REQ: 62], [REQ: 33]                       |batch_bump_allocator       |
+ * | cargs_bump_       |                                              |                           |
+ * | allocator_init    | Schema with a bump allocator (not thread     |                           |
+ * |                   | safe) parses many jobs, whose lists grow, on |                           |
+ * |                   | multiple threads. Results of each job match  |                           |
+ * |                   | its input, workers allocate from the buffer. |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | Integer, Int64,   | * [REQ: 35]                                  |integer_types_parsing      |
+ * | UInt64, Size, Hex,|                                              |                           |
+ * | Octal, Binary     | Valid, out of range & invalid tokens.        |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 35], [REQ: 9]                        |integer_trailing_garbage   |
+ * |                   |                                              |                           |
+ * |                   | Integer value with trailing chars. Parsing   |                           |
+ * |                   | should fail.                                 |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | Double            | * [REQ: 36]                                  |double_parsing             |
+ * |                   |                                              |                           |
+ * |                   | Valid, out of range & invalid tokens, in the |                           |
+ * |                   | C locale and (if available) de_DE.           |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | CARGS_LISTOF_     | * [REQ: 37], [REQ: 17], [REQ: 18], [REQ: 15] |delimited_list_argument    |
+ * | DELIMITED,        |----------------------------------------------|---------------------------|
+ * | cargs_parse_input | Delimited values, given at once and          | Test# 1                   |
+ * |                   | individually. Parsing should pass.           |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | No values given. Default values are used.    | Test# 2                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | An empty value between delimiters.           | Test# 3                   |
+ * |                   | Parsing should fail.                         |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Values longer than 8 chars, split by 2 and   | Test# 4                   |
+ * |                   | by 5 delimiters. Parsing should pass.        |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_when_arg| * [REQ: 38], [REQ: 2], [REQ: 6]              |when_argument              |
+ * | cargs_parse_input |                                              |                           |
+ * |                   | Chain of conditions (-b when -l is 3, -l     |                           |
+ * |                   | when -m is fast).                            |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Whole chain is enabled. Parsing should pass. | Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -l given, when -m has another value. Parsing | Test# 2                   |
+ * |                   | should fail.                                 |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -b given, when -l has another value. Parsing | Test# 3                   |
+ * |                   | should fail.                                 |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_when_arg| * [REQ: 40]                                  |when_argument_cycle        |
+ * |                   |                                              |                           |
+ * |                   | Conditions of two arguments are on each other|                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input,| * [REQ: 39]                                  |condition_evaluated_once   |
+ * | cargs_print_help, |                                              |                           |
+ * | cargs_is_enabled  | Condition function is called once, even when |                           |
+ * |                   | it is needed many times.                     |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_group,  | * [REQ: 41], [REQ: 42], [REQ: 43]            |argument_groups            |
+ * | cargs_parse_input |                                              |                           |
+ * |                   | -e and -d in a mutex and an at least one     |                           |
+ * |                   | group (exactly one), -u and -p together.     |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | All groups are satisfied. Parsing should pass| Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Both -e and -d given. Parsing should fail.   | Test# 2                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Only -u given. Parsing should fail.          | Test# 3                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Neither -e nor -d given. Parsing should fail.| Test# 4                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_add_group,  | * [REQ: 64]                                  |many_groups                |
+ * | cargs_parse_input |                                              |                           |
+ * |                   | 40 mutex groups of two flags each. One flag  |                           |
+ * |                   | of every group passes, both flags of the last|                           |
+ * |                   | group fail.                                  |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | CARGS_LAZY,       | * [REQ: 44], [REQ: 45]                       |lazy_argument              |
+ * | cargs_parse_input,|                                              |                           |
+ * | cargs_get         | Lazy args of a type which counts conversions |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Valid values. Parsing should pass, values    | Test# 1                   |
+ * |                   | are converted once, on access.               |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Value fails the check. Parsing should fail.  | Test# 2                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Value passes the check but fails the         | Test# 3                   |
+ * |                   | conversion. Parsing should pass, access      |                           |
+ * |                   | should fail.                                 |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | CARGS_LAZY,       | * [REQ: 61], [REQ: 45]                       |lazy_builtin_argument      |
+ * | cargs_parse_input,|                                              |                           |
+ * | cargs_get         | Lazy arg of a built-in type is given a value.|                           |
+ * |                   | Parsing passes (& access too) if the value is|                           |
+ * |                   | valid, otherwise it fails.                   |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Integer, with a valid value, trailing garbage| Test# 1-3                 |
+ * |                   | and a value out of range.                    |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | UInt64 & Hex, with valid & invalid values.   | Test# 4-7                 |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Double, with a valid & an invalid value.     | Test# 8-9                 |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Boolean, with a valid & an invalid value.    | Test# 10-11               |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_get_stats   | * [REQ: 46]                                  |parse_statistics           |
+ * |                   |                                              |                           |
+ * |                   | Scalar, list and conditional args are added  |                           |
+ * |                   | and parsed. Counts match what was parsed.    |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_format_help | * [REQ: 47]                                  |format_help                |
+ * |                   |                                              |                           |
+ * |                   | Help is formatted into a buffer large enough |                           |
+ * |                   | and into a smaller one.                      |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_use_        | * [REQ: 48]                                  |custom_allocator           |
+ * | allocator,        |                                              |                           |
+ * | cargs_set_default_| Args are added, parsed and cleaned up with a |                           |
+ * | allocator         | counting allocator. Nothing is left live.    |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Allocator of the parser.                     | Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Default allocator.                           | Test# 2                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Allocator of the parser with an arena owned  | Test# 3                   |
+ * |                   | by cargs. Only the arena is allocated.       |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_bump_       | * [REQ: 49]                                  |bump_allocator             |
+ * | allocator_init    |                                              |                           |
+ * |                   | Args are added with a bump allocator. Values |                           |
+ * |                   | are in its buffer. Parsing should pass.      |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_use_arena,  | * [REQ: 60], [REQ: 49]                       |unaligned_buffer           |
+ * | cargs_bump_       |                                              |                           |
+ * | allocator_init    | Args are added & parsed with a buffer which  |                           |
+ * |                   | is not aligned. Args & values are aligned.   |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Arena.                                       | Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Bump allocator.                              | Test# 2                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 50], [REQ: 51]                       |abbreviated_names          |
+ * |                   |                                              |                           |
+ * |                   | -verbose, -version, -level and -v are added. |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -verb and -lev are given. Parsing should pass| Test# 1                   |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -v is given, which is a full name. Parsing   | Test# 2                   |
+ * |                   | should pass.                                 |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -ver is given. Parsing should fail.          | Test# 3                   |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_complete    | * [REQ: 53]                                  |name_completion            |
+ * |                   |                                              |                           |
+ * |                   | Names are listed for prefixes with many, one |                           |
+ * |                   | and no names, in a list which is too short.  |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 52]                                  |name_suggestion            |
+ * |                   |                                              |                           |
+ * |                   | Names with a missing, a replaced and swapped |                           |
+ * |                   | chars are suggested the closest name. Too    |                           |
+ * |                   | short and too different names are not.       |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
+ * | cargs_parse_input | * [REQ: 54], [REQ: 55], [REQ: 56]            |token_forms                |
+ * |                   |                                              |                           |
+ * |                   | Flags -a, -b, -c, Integer -n, Double -d,     |                           |
+ * |                   | Integer list -v, String -level and a list    |                           |
+ * |                   | -bound of a custom type are added.           |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Values given as name=value, with -name and   | Test# 1                   |
+ * |                   | --name. Parsing should pass.                 |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Flags given together, then with -n last.     | Test# 2                   |
+ * |                   | Parsing should pass.                         |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Negative values given to -n, -d and -v.      | Test# 3                   |
+ * |                   | Parsing should pass.                         |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Value given to a flag as name=value.         | Test# 4                   |
+ * |                   | Parsing should fail.                         |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Negative number given after a flag. Parsing  | Test# 5                   |
+ * |                   | should fail.                                 |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | Value given before any argument. Parsing     | Test# 6                   |
+ * |                   | should fail.                                 |                           |
+ * |                   |----------------------------------------------|---------------------------|
+ * |                   | -inf, -3 and inf given to a list of a custom | Test# 7                   |
+ * |                   | type with check_string. Parsing should pass. |                           |
+ * |-------------------|----------------------------------------------|---------------------------|
  **************************************************************************************************/
 
 #define ARRAY_LEN(a) (sizeof (a) / sizeof (a[0]))
@@ -423,6 +762,1212 @@ YT_TEST (cargs, dup_args_add_must_fail)
     YT_END();
 }
 
+YT_TEST (cargs, readd_args_after_cleanup)
+{
+    cargs_add_arg ("in", "Arg 0", Integer, NULL);
+    cargs_add_arg ("out", "Arg 1", Integer, NULL);
+    cargs_cleanup();
+
+    int* out = cargs_add_arg ("out", "Arg 1", Integer, NULL);
+    int* in  = cargs_add_arg ("in", "Arg 0", Integer, NULL);
+
+    char* argv[] = { "dummy", "-in", "1", "-out", "2", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_SCALAR (*in, 1);
+    YT_EQ_SCALAR (*out, 2);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+#define TEST_STATIC_ARGS(ARG, LIST)                                    \
+    ARG (verbose, "v", "Verbose", Flag, bool, false, "false")          \
+    ARG (count, "n", "Count", Integer, int, 13, "13")                  \
+    ARG (name, "N", "Name", String, Cargs_StringType, "abc", "abc")    \
+    ARG (ratio, "r", "Ratio", Double, double, 0, NULL)                 \
+    LIST (files, "I", "Input files", String)
+
+CARGS_STATIC_SCHEMA (test_schema, TEST_STATIC_ARGS)
+
+YT_TEST (cargs, static_schema)
+{
+    // Defaults are available even before the schema was added.
+    YT_EQ_SCALAR (test_schema.verbose, false);
+    YT_EQ_SCALAR (test_schema.count, 13);
+    YT_EQ_STRING (test_schema.name, "abc");
+
+    cargs_add_static_schema (test_schema);
+
+    char* argv[] = { "dummy", "-v", "-r", "1.5", "-I", "a", "b", "c", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+
+    YT_EQ_SCALAR (test_schema.verbose, true);
+    YT_EQ_SCALAR (test_schema.count, 13);
+    YT_EQ_STRING (test_schema.name, "abc");
+    YT_EQ_DOUBLE_REL (test_schema.ratio, 1.5, 0.001);
+    YT_EQ_SCALAR (test_schema.files.len, 3U);
+    YT_EQ_STRING (((Cargs_StringType*)test_schema.files.buffer)[2], "c");
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, static_schema_reuse)
+{
+    cargs_add_static_schema (test_schema);
+    char* argv[] = { "dummy", "-v", "-n", "42", "-r", "1.5", "-I", "a", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_SCALAR (test_schema.count, 42);
+    cargs_cleanup();
+
+    cargs_add_static_schema (test_schema);
+    YT_EQ_SCALAR (test_schema.verbose, false);
+    YT_EQ_SCALAR (test_schema.count, 13);
+
+    char* argv2[] = { "dummy", "-r", "2", "-I", "b", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv2), argv2));
+    YT_EQ_SCALAR (test_schema.verbose, false);
+    YT_EQ_SCALAR (test_schema.count, 13);
+    YT_EQ_STRING (test_schema.name, "abc");
+    YT_EQ_SCALAR (test_schema.files.len, 1U);
+
+    // Schema is still in use by the default parser
+    Cargs_Parser other = { 0 };
+    cargs_parser_add_static_schema (&other, test_schema);
+    YT_EQ_SCALAR (other.CARGS__arg_count, 0U);
+    YT_EQ_SCALAR (test_schema.count, 13);
+
+    YT_MUST_CALL_IN_ORDER (cargs_panic, _);
+    YT_END();
+}
+
+#define TEST_MISMATCHED_ARGS(ARG, LIST)              \
+    ARG (count, "n", "Count", Integer, int, 1, "1")  \
+    ARG (ratio, "r", "Ratio", Double, int, 0, "1.5") \
+    ARG (guard, "g", "Guard", Integer, int, 7, "7")
+
+CARGS_STATIC_SCHEMA (mismatched_schema, TEST_MISMATCHED_ARGS)
+
+YT_TEST (cargs, static_schema_type_mismatch)
+{
+    cargs_add_static_schema (mismatched_schema);
+    YT_EQ_SCALAR (CARGS__default_parser.CARGS__arg_count, 0U);
+    YT_EQ_SCALAR (mismatched_schema.guard, 7); // Not overwritten by the value of -r
+
+    YT_MUST_CALL_IN_ORDER (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, string_view_argument)
+{
+    char* argv[] = {
+        "dummy", "-A", "123456789ABCD", "-B", "/a/long/path/1", "/a/long/path/2", NULL
+    };
+
+    Cargs_StringView* a = cargs_add_arg ("A", "1st arg", StringView, NULL);
+    Cargs_ArrayList* b  = cargs_add_arg ("B", "2nd arg", CARGS_LISTOF (StringView), NULL);
+    Cargs_StringView* c = cargs_add_arg ("C", "3rd arg", StringView, "default");
+
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+
+    YT_EQ_SCALAR (a->str, argv[2]); // Not a copy
+    YT_EQ_SCALAR (a->len, 13U);     // Not clamped
+    YT_EQ_SCALAR (b->len, 2U);
+    YT_EQ_SCALAR (((Cargs_StringView*)b->buffer)[1].str, argv[5]);
+    YT_EQ_STRING (c->str, "default");
+    YT_EQ_SCALAR (c->len, 7U);
+
+    YT_END();
+}
+
+static void write_temp_file (char* path_template, const char* text, size_t len)
+{
+    int fd = mkstemp (path_template);
+    assert (fd >= 0);
+
+    ssize_t written = write (fd, text, len);
+    assert (written == (ssize_t)len);
+    CARGS_UNUSED (written);
+
+    close (fd);
+}
+
+YT_TESTP (cargs, response_file, bool)
+{
+    bool is_null_delimited = YT_ARG_0();
+
+    // Response file text, without the null byte at the end of the string literal.
+    static const char new_line_text[] = "-A\nabc\r\n\n-B\n\"x \\\"y\\\"\nz\"\nw";
+    static const char null_text[]     = "-A\0abc\0-B\0x \"y\"\nz\0w\0";
+
+    char path[] = "/tmp/cargs_test_XXXXXX";
+    if (is_null_delimited) {
+        write_temp_file (path, null_text, sizeof (null_text) - 1);
+    } else {
+        write_temp_file (path, new_line_text, sizeof (new_line_text) - 1);
+    }
+
+    char response_file_arg[sizeof (path) + 1] = "@";
+    strcat (response_file_arg, path);
+
+    char* a            = cargs_add_arg ("A", "1st arg", String, NULL);
+    Cargs_ArrayList* b = cargs_add_arg ("B", "2nd arg", CARGS_LISTOF (StringView), NULL);
+    int* c             = cargs_add_arg ("C", "3rd arg", Integer, NULL);
+
+    char* argv[] = { "dummy", response_file_arg, "-C", "12", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    unlink (path);
+
+    YT_EQ_STRING (a, "abc");
+    YT_EQ_SCALAR (b->len, 2U);
+    YT_EQ_STRING (((Cargs_StringView*)b->buffer)[0].str, "x \"y\"\nz");
+    YT_EQ_STRING (((Cargs_StringView*)b->buffer)[1].str, "w");
+    YT_EQ_SCALAR (*c, 12);
+
+    YT_END();
+}
+
+YT_TEST (cargs, response_file_missing)
+{
+    cargs_add_arg ("A", "1st arg", String, NULL);
+
+    char* argv[] = { "dummy", "@/nonexistent/cargs_response_file", NULL };
+    YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+
+    YT_END();
+}
+
+YT_TESTP (cargs, response_file_escape, bool)
+{
+    bool is_off = YT_ARG_0();
+
+    char* a            = cargs_add_arg ("A", "1st arg", String, NULL);
+    Cargs_ArrayList* b = cargs_add_arg ("B", "2nd arg", CARGS_LISTOF (StringView), NULL);
+
+    if (is_off) {
+        cargs_use_response_files (false);
+        char* argv[] = { "dummy", "-A", "@user", "-B", "@x", "@@y", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_STRING (((Cargs_StringView*)b->buffer)[1].str, "@@y");
+    } else {
+        char* argv[] = { "dummy", "-A", "@@user", "-B", "@@x", "@@y", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_STRING (((Cargs_StringView*)b->buffer)[1].str, "@y");
+    }
+    YT_EQ_STRING (a, "@user");
+    YT_EQ_SCALAR (b->len, 2U);
+    YT_EQ_STRING (((Cargs_StringView*)b->buffer)[0].str, "@x");
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+static int stream_values[10];
+static unsigned stream_value_count;
+
+static bool on_stream_value (void* value)
+{
+    int v = *(int*)value;
+    if (v >= 100 || stream_value_count >= ARRAY_LEN (stream_values)) {
+        return false;
+    }
+    stream_values[stream_value_count++] = v;
+    return true;
+}
+
+typedef enum {
+    TEST_STREAM_VALUES,
+    TEST_STREAM_DEFAULT,
+    TEST_STREAM_REJECTED,
+} TEST_STREAM_CASE;
+
+YT_TESTP (cargs, stream_type_argument, TEST_STREAM_CASE)
+{
+    TEST_STREAM_CASE test_case = YT_ARG_0();
+    stream_value_count         = 0;
+
+    cargs_add_arg ("A", "1st arg", CARGS_STREAMOF (Integer, on_stream_value), "7");
+    bool* b = cargs_add_arg ("B", "2nd arg", Flag, "false");
+
+    if (test_case == TEST_STREAM_VALUES) {
+        char* argv[] = { "dummy", "-A", "1", "2", "-B", "-A", "3", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*b, true);
+        YT_EQ_SCALAR (stream_value_count, 3U);
+        YT_EQ_SCALAR (stream_values[0], 1);
+        YT_EQ_SCALAR (stream_values[1], 2);
+        YT_EQ_SCALAR (stream_values[2], 3);
+    } else if (test_case == TEST_STREAM_DEFAULT) {
+        char* argv[] = { "dummy", "-B", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (stream_value_count, 1U);
+        YT_EQ_SCALAR (stream_values[0], 7);
+    } else {
+        char* argv[] = { "dummy", "-A", "1", "100", "2", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (stream_value_count, 1U);
+    }
+
+    YT_END();
+}
+
+YT_TEST (cargs, independent_parsers)
+{
+    Cargs_Parser first = { 0 }, second = { 0 };
+
+    int* first_count  = cargs_parser_add_arg (&first, "n", "Count", Integer, NULL);
+    int* second_count = cargs_parser_add_arg (&second, "n", "Count", Integer, "7");
+    Cargs_ArrayList* first_list  = cargs_parser_add_arg (&first, "l", "List",
+                                                         CARGS_LISTOF (Integer), NULL);
+    Cargs_ArrayList* second_list = cargs_parser_add_arg (&second, "l", "List",
+                                                         CARGS_LISTOF (Integer), NULL);
+
+    char* first_argv[]  = { "dummy", "-n", "1", "-l", "1", "2", NULL };
+    char* second_argv[] = { "dummy", "-l", "3", NULL };
+
+    YT_EQ_SCALAR (true, cargs_parser_parse_input (&first, ARRAY_LEN (first_argv), first_argv));
+    YT_EQ_SCALAR (true, cargs_parser_parse_input (&second, ARRAY_LEN (second_argv), second_argv));
+
+    YT_EQ_SCALAR (*first_count, 1);
+    YT_EQ_SCALAR (*second_count, 7);
+    YT_EQ_SCALAR (first_list->len, 2U);
+    YT_EQ_SCALAR (second_list->len, 1U);
+    YT_EQ_SCALAR (((int*)first_list->buffer)[1], 2);
+    YT_EQ_SCALAR (((int*)second_list->buffer)[0], 3);
+
+    // Default parser is not affected
+    YT_EQ_SCALAR (CARGS__default_parser.CARGS__arg_count, 0U);
+
+    cargs_parser_cleanup (&first);
+    cargs_parser_cleanup (&second);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+#define TEST_BATCH_JOB_COUNT     300
+#define TEST_BATCH_FAILING_JOB   150
+#define TEST_BATCH_DEFAULT_COUNT 7
+
+static void on_batch_result (size_t job_index, Cargs_Parser* result, void* user_data)
+{
+    int* results          = (int*)user_data;
+    int* count            = (int*)cargs_parser_get (result, "n");
+    Cargs_ArrayList* list = (Cargs_ArrayList*)cargs_parser_get (result, "l");
+
+    results[job_index] = *count * 10 + (int)list->len;
+}
+
+YT_TEST (cargs, batch_parsing)
+{
+    static char counts[TEST_BATCH_JOB_COUNT][8];
+    static char* argvs[TEST_BATCH_JOB_COUNT][7];
+    static Cargs_BatchJob jobs[TEST_BATCH_JOB_COUNT];
+    static int results[TEST_BATCH_JOB_COUNT];
+
+    Cargs_Parser schema = { 0 };
+    cargs_parser_add_arg (&schema, "n", "Count", Integer, "7");
+    cargs_parser_add_arg (&schema, "l", "List", CARGS_LISTOF (Integer), NULL);
+
+    for (int i = 0; i < TEST_BATCH_JOB_COUNT; i++) {
+        snprintf (counts[i], sizeof (counts[i]), "%d", i);
+        if (i == TEST_BATCH_FAILING_JOB) {
+            char* argv[] = { "dummy", "-l", "1", "-x", NULL }; // Unknown argument
+            memcpy (argvs[i], argv, sizeof (argv));
+            jobs[i] = (Cargs_BatchJob){ .argc = ARRAY_LEN (argv), .argv = argvs[i] };
+        } else if (i % 2 == 0) {
+            char* argv[] = { "dummy", "-n", counts[i], "-l", "1", "2", NULL };
+            memcpy (argvs[i], argv, sizeof (argv));
+            jobs[i] = (Cargs_BatchJob){ .argc = ARRAY_LEN (argv), .argv = argvs[i] };
+        } else {
+            char* argv[] = { "dummy", "-l", "3", NULL };
+            memcpy (argvs[i], argv, sizeof (argv));
+            jobs[i] = (Cargs_BatchJob){ .argc = ARRAY_LEN (argv), .argv = argvs[i] };
+        }
+    }
+
+    // Parser must be frozen first
+    YT_EQ_SCALAR (false, cargs_parse_batch (&schema, jobs, TEST_BATCH_JOB_COUNT, 4,
+                                            on_batch_result, results));
+    cargs_parser_freeze (&schema);
+    YT_EQ_SCALAR (false, cargs_parser_parse_input (&schema, jobs[0].argc, jobs[0].argv));
+
+    YT_EQ_SCALAR (false, cargs_parse_batch (&schema, jobs, TEST_BATCH_JOB_COUNT, 4,
+                                            on_batch_result, results));
+
+    for (int i = 0; i < TEST_BATCH_JOB_COUNT; i++) {
+        if (i == TEST_BATCH_FAILING_JOB) {
+            YT_EQ_SCALAR (jobs[i].is_ok, false);
+        } else if (i % 2 == 0) {
+            YT_EQ_SCALAR (jobs[i].is_ok, true);
+            YT_EQ_SCALAR (results[i], i * 10 + 2);
+        } else {
+            YT_EQ_SCALAR (jobs[i].is_ok, true);
+            YT_EQ_SCALAR (results[i], TEST_BATCH_DEFAULT_COUNT * 10 + 1);
+        }
+    }
+
+    // Schema itself is never modified
+    YT_EQ_SCALAR (*(int*)cargs_parser_get (&schema, "n"), TEST_BATCH_DEFAULT_COUNT);
+    YT_EQ_SCALAR (((Cargs_ArrayList*)cargs_parser_get (&schema, "l"))->len, 0U);
+
+    cargs_parser_cleanup (&schema);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, batch_bump_allocator)
+{
+    static _Alignas (max_align_t) unsigned char buffer[64 * 1024];
+    static char counts[TEST_BATCH_JOB_COUNT][8];
+    static Cargs_BatchJob jobs[TEST_BATCH_JOB_COUNT];
+    static int results[TEST_BATCH_JOB_COUNT];
+    // Values do not fit in the inline buffer of the list, so workers allocate while parsing too.
+    static char* argvs[TEST_BATCH_JOB_COUNT][15];
+
+    Cargs_BumpAllocator bump;
+    Cargs_Parser schema        = { 0 };
+    Cargs_Allocator* allocator = cargs_bump_allocator_init (&bump, buffer, sizeof (buffer));
+    cargs_parser_use_allocator (&schema, allocator);
+    cargs_parser_add_arg (&schema, "n", "Count", Integer, "7");
+    cargs_parser_add_arg (&schema, "l", "List", CARGS_LISTOF (Integer), NULL);
+    cargs_parser_freeze (&schema);
+    size_t schema_used = bump.CARGS__arena.used;
+
+    for (int i = 0; i < TEST_BATCH_JOB_COUNT; i++) {
+        snprintf (counts[i], sizeof (counts[i]), "%d", i);
+        char* argv[] = { "dummy", "-n", counts[i], "-l", "1", "2", "3", "4",
+                         "5",     "6",  "7",       "8",  "9", "10", NULL };
+        memcpy (argvs[i], argv, sizeof (argv));
+        jobs[i] = (Cargs_BatchJob){ .argc = ARRAY_LEN (argv), .argv = argvs[i] };
+    }
+
+    YT_EQ_SCALAR (true, cargs_parse_batch (&schema, jobs, TEST_BATCH_JOB_COUNT, 4,
+                                           on_batch_result, results));
+    for (int i = 0; i < TEST_BATCH_JOB_COUNT; i++) {
+        YT_EQ_SCALAR (results[i], i * 10 + 10);
+    }
+    YT_EQ_SCALAR (bump.CARGS__arena.used > schema_used, true);
+
+    cargs_parser_cleanup (&schema);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+static bool parse_as (Cargs_TypeInterface interface, const char* input, void* out)
+{
+    interface.CARGS__value = out;
+    return interface.parse_string (&interface, input, CARGS__SLICE_OF (out, interface.type_size));
+}
+
+#define TEST_BATCH_LATE_ARG_COUNT 100
+
+YT_TEST (cargs, batch_group_before_args)
+{
+    static char names[TEST_BATCH_LATE_ARG_COUNT][8];
+    char* valid_argv[]   = { "dummy", "-e", "-x99", "5", NULL };
+    char* invalid_argv[] = { "dummy", "-e", "-d", "-x0", "1", NULL };
+    Cargs_BatchJob jobs[] = {
+        { .argc = ARRAY_LEN (valid_argv), .argv = valid_argv },
+        { .argc = ARRAY_LEN (invalid_argv), .argv = invalid_argv },
+    };
+
+    Cargs_Parser schema = { 0 };
+    cargs_parser_add_arg (&schema, "e", "Encrypt", Flag, "false");
+    cargs_parser_add_arg (&schema, "d", "Decrypt", Flag, "false");
+    cargs_parser_add_group (&schema, CARGS_GROUP_MUTEX, "e", "d");
+    // Group members have room only for the arguments added before the group.
+    for (int i = 0; i < TEST_BATCH_LATE_ARG_COUNT; i++) {
+        snprintf (names[i], sizeof (names[i]), "-x%d", i);
+        CARGS__parser_add_arg (&schema, names[i], "Extra", Integer, "0", NULL, NULL);
+    }
+    cargs_parser_freeze (&schema);
+
+    YT_EQ_SCALAR (false, cargs_parse_batch (&schema, jobs, ARRAY_LEN (jobs), 2, NULL, NULL));
+    YT_EQ_SCALAR (jobs[0].is_ok, true);
+    YT_EQ_SCALAR (jobs[1].is_ok, false);
+
+    cargs_parser_cleanup (&schema);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, integer_types_parsing)
+{
+    int i        = 0;
+    int64_t i64  = 0;
+    uint64_t u64 = 0;
+    size_t size  = 0;
+
+    YT_EQ_SCALAR (true, parse_as (Integer, "-2147483648", &i));
+    YT_EQ_SCALAR (i, INT_MIN);
+    YT_EQ_SCALAR (true, parse_as (Integer, "+2147483647", &i));
+    YT_EQ_SCALAR (i, INT_MAX);
+    YT_EQ_SCALAR (false, parse_as (Integer, "2147483648", &i));
+    YT_EQ_SCALAR (false, parse_as (Integer, "", &i));
+    YT_EQ_SCALAR (false, parse_as (Integer, "-", &i));
+    YT_EQ_SCALAR (false, parse_as (Integer, "12 ", &i));
+    YT_EQ_SCALAR (false, parse_as (Integer, "0x12", &i));
+
+    // SWAR (8 digits at a time) and the remaining digits
+    YT_EQ_SCALAR (true, parse_as (Int64, "-9223372036854775808", &i64));
+    YT_EQ_SCALAR (i64, INT64_MIN);
+    YT_EQ_SCALAR (true, parse_as (Int64, "1234567890123", &i64));
+    YT_EQ_SCALAR (i64, 1234567890123LL);
+    YT_EQ_SCALAR (false, parse_as (Int64, "9223372036854775808", &i64));
+    YT_EQ_SCALAR (false, parse_as (Int64, "12345678a", &i64));
+    YT_EQ_SCALAR (false, parse_as (Int64, "1234a678", &i64));
+
+    YT_EQ_SCALAR (true, parse_as (UInt64, "18446744073709551615", &u64));
+    YT_EQ_SCALAR (u64 == UINT64_MAX, true);
+    YT_EQ_SCALAR (false, parse_as (UInt64, "18446744073709551616", &u64));
+    YT_EQ_SCALAR (false, parse_as (UInt64, "-1", &u64));
+
+    YT_EQ_SCALAR (true, parse_as (Size, "4096", &size));
+    YT_EQ_SCALAR (size, 4096U);
+
+    YT_EQ_SCALAR (true, parse_as (Hex, "0xFFffFFffFFffFFff", &u64));
+    YT_EQ_SCALAR (u64 == UINT64_MAX, true);
+    YT_EQ_SCALAR (true, parse_as (Hex, "1aF", &u64));
+    YT_EQ_SCALAR (u64, 0x1AFU);
+    YT_EQ_SCALAR (false, parse_as (Hex, "0x", &u64));
+    YT_EQ_SCALAR (false, parse_as (Hex, "0x1G", &u64));
+    YT_EQ_SCALAR (false, parse_as (Hex, "0x10000000000000000", &u64));
+
+    YT_EQ_SCALAR (true, parse_as (Octal, "0o755", &u64));
+    YT_EQ_SCALAR (u64, 0755U);
+    YT_EQ_SCALAR (false, parse_as (Octal, "8", &u64));
+
+    YT_EQ_SCALAR (true, parse_as (Binary, "0B101", &u64));
+    YT_EQ_SCALAR (u64, 5U);
+    YT_EQ_SCALAR (false, parse_as (Binary, "0b12", &u64));
+
+    YT_END();
+}
+
+YT_TEST (cargs, integer_trailing_garbage)
+{
+    cargs_add_arg ("n", "Count", Integer, NULL);
+
+    char* argv[] = { "dummy", "-n", "12abc", NULL };
+    YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+static void check_double_parsing (void)
+{
+    double d = 0;
+
+    // Fast path
+    YT_EQ_SCALAR (true, parse_as (Double, "0.1", &d));
+    YT_EQ_SCALAR (d == 0.1, true);
+    YT_EQ_SCALAR (true, parse_as (Double, "-1.5e-3", &d));
+    YT_EQ_SCALAR (d == -1.5e-3, true);
+    YT_EQ_SCALAR (true, parse_as (Double, ".5", &d));
+    YT_EQ_SCALAR (d == 0.5, true);
+    YT_EQ_SCALAR (true, parse_as (Double, "+5.", &d));
+    YT_EQ_SCALAR (d == 5.0, true);
+
+    // Slow path
+    YT_EQ_SCALAR (true, parse_as (Double, "9007199254740993", &d)); // 2^53 + 1, rounds to even
+    YT_EQ_SCALAR (d == 9007199254740992.0, true);
+    YT_EQ_SCALAR (true, parse_as (Double, "2.2250738585072014e-308", &d));
+    YT_EQ_SCALAR (d == 2.2250738585072014e-308, true);
+    YT_EQ_SCALAR (true, parse_as (Double, "0.10000000000000000000000000001", &d));
+    YT_EQ_SCALAR (d == 0.1, true);
+    YT_EQ_SCALAR (true, parse_as (Double, "1e-400", &d));
+    YT_EQ_SCALAR (d == 0.0, true);
+    YT_EQ_SCALAR (false, parse_as (Double, "1e400", &d));
+
+    YT_EQ_SCALAR (true, parse_as (Double, "-INF", &d));
+    YT_EQ_SCALAR (d == -__builtin_inf(), true);
+    YT_EQ_SCALAR (true, parse_as (Double, "nan", &d));
+    YT_EQ_SCALAR (d != d, true);
+
+    YT_EQ_SCALAR (false, parse_as (Double, "", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, ".", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, "1.5x", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, "1,5", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, "1e", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, "1e+", &d));
+    YT_EQ_SCALAR (false, parse_as (Double, "0x1p3", &d));
+}
+
+YT_TEST (cargs, double_parsing)
+{
+    check_double_parsing();
+
+    // Decimal point is ',' in this locale, which must not change the parsing.
+    if (setlocale (LC_NUMERIC, "de_DE.UTF-8") != NULL) {
+        check_double_parsing();
+        setlocale (LC_NUMERIC, "C");
+    }
+
+    YT_END();
+}
+
+typedef enum {
+    TEST_DELIMITED_VALUES,
+    TEST_DELIMITED_DEFAULT,
+    TEST_DELIMITED_EMPTY_VALUE,
+    TEST_DELIMITED_LONG_VALUES,
+} TEST_DELIMITED_CASE;
+
+YT_TESTP (cargs, delimited_list_argument, TEST_DELIMITED_CASE)
+{
+    TEST_DELIMITED_CASE test_case = YT_ARG_0();
+
+    Cargs_ArrayList* list = cargs_add_arg ("w", "Weights", CARGS_LISTOF_DELIMITED (Integer, ",;"),
+                                           "7,8");
+    int* items            = NULL;
+
+    if (test_case == TEST_DELIMITED_VALUES) {
+        char* argv[] = { "dummy", "-w", "1,2;3", "4", "-w", "5,6", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (list->len, 6U);
+        items = (int*)list->buffer;
+        for (int i = 0; i < 6; i++) {
+            YT_EQ_SCALAR (items[i], i + 1);
+        }
+    } else if (test_case == TEST_DELIMITED_DEFAULT) {
+        char* argv[] = { "dummy", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (list->len, 2U);
+        items = (int*)list->buffer;
+        YT_EQ_SCALAR (items[0], 7);
+        YT_EQ_SCALAR (items[1], 8);
+    } else if (test_case == TEST_DELIMITED_EMPTY_VALUE) {
+        char* argv[] = { "dummy", "-w", "1,,2", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else {
+        // Delimiters are found 8 chars at a time for up to 4 delimiters, one at a time for more.
+        Cargs_ArrayList* more = cargs_add_arg ("s", "Sizes",
+                                               CARGS_LISTOF_DELIMITED (Integer, ",;:/ "), NULL);
+        char* argv[] = { "dummy", "-w", "10000001;2,300000003;40000004,5",
+                         "-s", "10000001:2/30000003 4", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (list->len, 5U);
+        items = (int*)list->buffer;
+        YT_EQ_SCALAR (items[0], 10000001);
+        YT_EQ_SCALAR (items[2], 300000003);
+        YT_EQ_SCALAR (items[3], 40000004);
+        YT_EQ_SCALAR (items[4], 5);
+        YT_EQ_SCALAR (more->len, 4U);
+        items = (int*)more->buffer;
+        YT_EQ_SCALAR (items[1], 2);
+        YT_EQ_SCALAR (items[2], 30000003);
+        YT_EQ_SCALAR (items[3], 4);
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+typedef enum {
+    TEST_WHEN_ALL_ENABLED,
+    TEST_WHEN_FIRST_DISABLED,
+    TEST_WHEN_SECOND_DISABLED,
+} TEST_WHEN_CASE;
+
+YT_TESTP (cargs, when_argument, TEST_WHEN_CASE)
+{
+    TEST_WHEN_CASE test_case = YT_ARG_0();
+
+    // Conditions can be on arguments added later
+    bool* boost = cargs_add_when_arg ("l", "3", "b", "Boost", Flag, "false");
+    int* level  = cargs_add_when_arg ("m", "fast", "l", "Level", Integer, "1");
+    cargs_add_arg ("m", "Mode", String, "slow");
+
+    if (test_case == TEST_WHEN_ALL_ENABLED) {
+        char* argv[] = { "dummy", "-m", "fast", "-l", "3", "-b", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*level, 3);
+        YT_EQ_SCALAR (*boost, true);
+        YT_EQ_SCALAR (cargs_is_enabled ("b"), true);
+    } else if (test_case == TEST_WHEN_FIRST_DISABLED) {
+        char* argv[] = { "dummy", "-l", "3", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (cargs_is_enabled ("l"), false);
+        YT_EQ_SCALAR (cargs_is_enabled ("b"), false); // Since -l is disabled
+    } else {
+        char* argv[] = { "dummy", "-m", "fast", "-b", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (cargs_is_enabled ("l"), true);
+        YT_EQ_SCALAR (cargs_is_enabled ("b"), false);
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, when_argument_cycle)
+{
+    cargs_add_when_arg ("c", "1", "a", "Arg a", Integer, "1");
+    cargs_add_when_arg ("a", "1", "b", "Arg b", Integer, "1");
+    cargs_add_when_arg ("b", "1", "c", "Arg c", Integer, "1");
+    YT_MUST_CALL_IN_ORDER (cargs_panic, _);
+    YT_END();
+}
+
+static unsigned condition_call_count = 0;
+
+static bool counted_condition (void)
+{
+    condition_call_count++;
+    return true;
+}
+
+YT_TEST (cargs, condition_evaluated_once)
+{
+    condition_call_count = 0;
+    cargs_add_cond_arg (counted_condition, "A", "Arg A", Integer, "1");
+    cargs_add_when_arg ("A", "2", "B", "Arg B", Integer, "1");
+    cargs_add_when_arg ("A", "2", "C", "Arg C", Integer, "1");
+
+    char* argv[] = { "dummy", "-A", "2", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    cargs_print_help();
+    YT_EQ_SCALAR (cargs_is_enabled ("A"), true);
+    YT_EQ_SCALAR (cargs_is_enabled ("C"), true);
+
+    YT_EQ_SCALAR (condition_call_count, 1U);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+typedef enum {
+    TEST_GROUP_SATISFIED,
+    TEST_GROUP_MUTEX_VIOLATED,
+    TEST_GROUP_TOGETHER_VIOLATED,
+    TEST_GROUP_AT_LEAST_ONE_VIOLATED,
+} TEST_GROUP_CASE;
+
+YT_TESTP (cargs, argument_groups, TEST_GROUP_CASE)
+{
+    TEST_GROUP_CASE test_case = YT_ARG_0();
+
+    cargs_add_arg ("e", "Encrypt", Flag, "false");
+    cargs_add_arg ("d", "Decrypt", Flag, "false");
+    cargs_add_arg ("u", "User", String, "root");
+    cargs_add_arg ("p", "Password", String, "");
+    cargs_add_group (CARGS_GROUP_MUTEX, "e", "d");
+    cargs_add_group (CARGS_GROUP_AT_LEAST_ONE, "e", "d");
+    cargs_add_group (CARGS_GROUP_TOGETHER, "u", "p");
+
+    if (test_case == TEST_GROUP_SATISFIED) {
+        char* argv[] = { "dummy", "-d", "-u", "admin", "-p", "1234", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else if (test_case == TEST_GROUP_MUTEX_VIOLATED) {
+        char* argv[] = { "dummy", "-e", "-d", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else if (test_case == TEST_GROUP_TOGETHER_VIOLATED) {
+        char* argv[] = { "dummy", "-e", "-u", "admin", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else {
+        char* argv[] = { "dummy", "-u", "admin", "-p", "1234", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+#define TEST_MANY_GROUP_COUNT 40
+
+// Adds flags -e<i> and -d<i>, and a mutex group of both, for every i.
+static void test_add_many_groups (void)
+{
+    static char names[TEST_MANY_GROUP_COUNT * 2][8];
+    for (int i = 0; i < TEST_MANY_GROUP_COUNT * 2; i++) {
+        snprintf (names[i], sizeof (names[i]), "-%c%d", (i % 2) ? 'd' : 'e', i / 2);
+        CARGS__cargs_add_arg (names[i], "Flag", Flag, "false", NULL, NULL);
+    }
+    for (int i = 0; i < TEST_MANY_GROUP_COUNT * 2; i += 2) {
+        cargs_add_group (CARGS_GROUP_MUTEX, names[i] + 1, names[i + 1] + 1);
+    }
+}
+
+YT_TEST (cargs, many_groups)
+{
+    char* valid_argv[]   = { "dummy", "-e0", "-d20", "-e39", NULL };
+    char* invalid_argv[] = { "dummy", "-e0", "-e39", "-d39", NULL };
+
+    test_add_many_groups();
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (valid_argv), valid_argv));
+    cargs_cleanup();
+
+    test_add_many_groups();
+    YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (invalid_argv), invalid_argv));
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+static unsigned lazy_convert_count = 0;
+
+// Accepts any number, but converts only the ones that fit in an int.
+static bool test_lazy_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                    Cargs_Slice out)
+{
+    lazy_convert_count++;
+    return cargs_int_parse_string (self, input, out);
+}
+
+static bool test_lazy_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    CARGS_UNUSED (self);
+    return input[0] != '\0' && strspn (input, "0123456789") == strlen (input);
+}
+
+Cargs_TypeInterface TestLazyInterface = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .format_help  = "(number)",
+    .type_size    = sizeof (int),
+    .parse_string = test_lazy_parse_string,
+    .check_string = test_lazy_check_string,
+};
+
+typedef enum {
+    TEST_LAZY_VALID,
+    TEST_LAZY_CHECK_FAILS,
+    TEST_LAZY_CONVERSION_FAILS,
+} TEST_LAZY_CASE;
+
+YT_TESTP (cargs, lazy_argument, TEST_LAZY_CASE)
+{
+    TEST_LAZY_CASE test_case = YT_ARG_0();
+
+    lazy_convert_count = 0;
+    cargs_add_arg ("a", "Arg a", CARGS_LAZY (TestLazyInterface), NULL);
+    cargs_add_arg ("b", "Arg b", CARGS_LAZY (TestLazyInterface), "20");
+    YT_EQ_SCALAR (lazy_convert_count, 0U);
+
+    if (test_case == TEST_LAZY_VALID) {
+        char* argv[] = { "dummy", "-a", "10", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (lazy_convert_count, 0U);
+
+        YT_EQ_SCALAR (*(int*)cargs_get ("a"), 10);
+        YT_EQ_SCALAR (*(int*)cargs_get ("a"), 10);
+        YT_EQ_SCALAR (lazy_convert_count, 1U);
+        YT_EQ_SCALAR (*(int*)cargs_get ("b"), 20);
+        YT_EQ_SCALAR (lazy_convert_count, 2U);
+    } else if (test_case == TEST_LAZY_CHECK_FAILS) {
+        char* argv[] = { "dummy", "-a", "1x", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (lazy_convert_count, 0U);
+    } else {
+        char* argv[] = { "dummy", "-a", "99999999999", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (cargs_get ("a") == NULL, true);
+        YT_EQ_SCALAR (cargs_get ("a") == NULL, true);
+        YT_EQ_SCALAR (lazy_convert_count, 1U);
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TESTP (cargs, lazy_builtin_argument, Cargs_TypeInterface*, const char*, bool)
+{
+    Cargs_TypeInterface type = *YT_ARG_0();
+    const char* value        = YT_ARG_1();
+    bool is_valid            = YT_ARG_2();
+
+    cargs_add_arg ("a", "Arg a", CARGS_LAZY (type), NULL);
+
+    char* argv[] = { "dummy", "-a", (char*)value, NULL };
+    YT_EQ_SCALAR (cargs_parse_input (ARRAY_LEN (argv), argv), is_valid);
+    if (is_valid) {
+        YT_EQ_SCALAR (cargs_get ("a") != NULL, true);
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, parse_statistics)
+{
+    cargs_add_arg ("a", "Arg a", Integer, NULL);
+    Cargs_ArrayList* list = cargs_add_arg ("b", "Arg b", CARGS_LISTOF (Integer), NULL);
+    cargs_add_cond_arg (always_true, "c", "Arg c", Boolean, "false");
+
+    // 11 list values grow the list once
+    char* argv[] = { "dummy", "-a", "1", "-b", "1", "2", "3", "4",  "5",
+                     "6",     "7",  "8", "9",  "10", "11", NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_SCALAR (cargs_is_enabled ("c"), true);
+
+    Cargs_Stats stats = cargs_get_stats();
+    YT_EQ_SCALAR (stats.type_count, 2U);
+    // Types are in the order of their first conversion (default value of -c is the first).
+    YT_EQ_SCALAR (stats.types[0].parse_string == Boolean.parse_string, true);
+    YT_EQ_SCALAR (stats.types[0].parse_count, 1UL);
+    YT_EQ_SCALAR (stats.types[1].parse_string == Integer.parse_string, true);
+    YT_EQ_SCALAR (stats.types[1].parse_count, 12UL);
+    YT_EQ_SCALAR (stats.is_enabled_fn_count, 1UL);
+    YT_EQ_SCALAR (stats.list_growth_count, 1UL);
+    YT_EQ_SCALAR (stats.value_bytes, sizeof (int) + sizeof (Cargs_ArrayList) +
+                                         list->capacity * sizeof (int) + sizeof (bool));
+    YT_EQ_SCALAR (stats.register_ns > 0, true);
+    YT_EQ_SCALAR (stats.tokenize_ns > 0, true);
+    YT_EQ_SCALAR (stats.convert_ns > 0, true);
+    YT_EQ_SCALAR (stats.validate_ns > 0, true);
+
+    cargs_cleanup();
+    stats = cargs_get_stats();
+    YT_EQ_SCALAR (stats.type_count, 0U);
+    YT_EQ_SCALAR (stats.register_ns, 0UL);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, format_help)
+{
+    cargs_add_arg ("h", "Shows usage", Help, "false");
+    cargs_add_arg ("name", "Name", String, NULL);
+    cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), "1");
+    cargs_add_cond_arg (always_false, "c", "Color", Boolean, "false");
+
+    size_t len = cargs_format_help (NULL, 0);
+
+    char full[1024];
+    YT_EQ_SCALAR (len < sizeof (full), true);
+    YT_EQ_SCALAR (cargs_format_help (full, sizeof (full)), len);
+    YT_EQ_SCALAR (strlen (full), len);
+    YT_EQ_SCALAR (strncmp (full, "Usage:\n", 7), 0);
+    YT_EQ_SCALAR (strstr (full, "Shows usage") != NULL, true);
+    YT_EQ_SCALAR (strstr (full, "(number)..") != NULL, true);
+    YT_EQ_SCALAR (strstr (full, "Conditional") != NULL, true);
+
+    char part[20];
+    YT_EQ_SCALAR (cargs_format_help (part, sizeof (part)), len);
+    YT_EQ_SCALAR (strlen (part), sizeof (part) - 1);
+    YT_EQ_SCALAR (strncmp (part, full, sizeof (part) - 1), 0);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+typedef struct {
+    Cargs_Allocator allocator;
+    size_t alloc_count;
+    size_t live_bytes;
+} TestAllocator;
+
+static void* test_reallocate (Cargs_Allocator* self, void* ptr, size_t old_size, size_t new_size)
+{
+    TestAllocator* allocator = CARGS_PARENT_OF (self, TestAllocator, allocator);
+    void* new_ptr            = realloc (ptr, new_size);
+    if (new_ptr != NULL) {
+        allocator->alloc_count += (ptr == NULL);
+        allocator->live_bytes += new_size - old_size;
+    }
+    return new_ptr;
+}
+
+static void test_deallocate (Cargs_Allocator* self, void* ptr, size_t size)
+{
+    TestAllocator* allocator = CARGS_PARENT_OF (self, TestAllocator, allocator);
+    allocator->live_bytes -= size;
+    free (ptr);
+}
+
+typedef enum {
+    TEST_ALLOCATOR_OF_PARSER,
+    TEST_ALLOCATOR_DEFAULT,
+    TEST_ALLOCATOR_WITH_ARENA,
+} TEST_ALLOCATOR_CASE;
+
+YT_TESTP (cargs, custom_allocator, TEST_ALLOCATOR_CASE)
+{
+    TEST_ALLOCATOR_CASE test_case = YT_ARG_0();
+    TestAllocator allocator       = {
+              .allocator = { .reallocate = test_reallocate, .deallocate = test_deallocate }
+    };
+
+    if (test_case == TEST_ALLOCATOR_DEFAULT) {
+        cargs_set_default_allocator (&allocator.allocator);
+    } else {
+        cargs_use_allocator (&allocator.allocator);
+    }
+    if (test_case == TEST_ALLOCATOR_WITH_ARENA) {
+        cargs_use_arena (NULL, 4096);
+    }
+
+    cargs_add_arg ("n", "Count", Integer, "1");
+    cargs_add_arg ("m", "Mode", String, "slow");
+    cargs_add_when_arg ("m", "fast", "l", "Level", Integer, "1");
+    Cargs_ArrayList* list = cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), NULL);
+
+    // List values do not fit in its inline buffer.
+    char* argv[] = { "dummy", "-m", "fast", "-l", "2", "-v", "1", "2", "3", "4", "5", "6", "7",
+                     "8",     "9",  "10",   NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_SCALAR (cargs_is_enabled ("l"), true);
+    YT_EQ_SCALAR (list->len, 10U);
+
+    YT_EQ_SCALAR (allocator.alloc_count, (test_case == TEST_ALLOCATOR_WITH_ARENA) ? 1U : 8U);
+    YT_EQ_SCALAR (allocator.live_bytes > 0, true);
+
+    cargs_cleanup();
+    YT_EQ_SCALAR (allocator.live_bytes, 0U);
+
+    cargs_use_allocator (NULL);
+    cargs_set_default_allocator (NULL);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, bump_allocator)
+{
+    static unsigned char buffer[4096];
+    Cargs_BumpAllocator bump;
+    cargs_use_allocator (cargs_bump_allocator_init (&bump, buffer, sizeof (buffer)));
+
+    int* n                = cargs_add_arg ("n", "Count", Integer, "1");
+    Cargs_ArrayList* list = cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), NULL);
+
+    char* argv[] = { "dummy", "-n", "5", "-v", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+                     NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_SCALAR (*n, 5);
+    YT_EQ_SCALAR (list->len, 10U);
+    YT_EQ_SCALAR (((int*)list->buffer)[9], 10);
+
+    YT_EQ_SCALAR ((unsigned char*)n > buffer && (unsigned char*)n < buffer + sizeof (buffer), true);
+    YT_EQ_SCALAR ((unsigned char*)list->buffer > buffer &&
+                      (unsigned char*)list->buffer < buffer + sizeof (buffer),
+                  true);
+
+    cargs_cleanup();
+    cargs_use_allocator (NULL);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+typedef enum {
+    TEST_UNALIGNED_ARENA,
+    TEST_UNALIGNED_BUMP_ALLOCATOR,
+} TEST_UNALIGNED_CASE;
+
+YT_TESTP (cargs, unaligned_buffer, TEST_UNALIGNED_CASE)
+{
+    TEST_UNALIGNED_CASE test_case = YT_ARG_0();
+
+    static _Alignas (max_align_t) unsigned char buffer[4096];
+    Cargs_BumpAllocator bump;
+    if (test_case == TEST_UNALIGNED_ARENA) {
+        cargs_use_arena (buffer + 1, sizeof (buffer) - 1);
+    } else {
+        cargs_use_allocator (cargs_bump_allocator_init (&bump, buffer + 1, sizeof (buffer) - 1));
+    }
+
+    double* d             = cargs_add_arg ("d", "Ratio", Double, "0.5");
+    Cargs_ArrayList* list = cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), NULL);
+
+    char* argv[] = { "dummy", "-d", "2.5", "-v", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+                     NULL };
+    YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+    YT_EQ_DOUBLE_REL (*d, 2.5, 0.001);
+    YT_EQ_SCALAR (list->len, 10U);
+    YT_EQ_SCALAR (((int*)list->buffer)[9], 10);
+
+    YT_EQ_SCALAR ((uintptr_t)d % _Alignof (max_align_t), 0U);
+    YT_EQ_SCALAR ((uintptr_t)list % _Alignof (max_align_t), 0U);
+    YT_EQ_SCALAR ((uintptr_t)list->buffer % _Alignof (max_align_t), 0U);
+
+    cargs_cleanup();
+    cargs_use_allocator (NULL);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+typedef enum {
+    TEST_ABBREV_UNIQUE,
+    TEST_ABBREV_FULL_NAME,
+    TEST_ABBREV_AMBIGUOUS,
+} TEST_ABBREV_CASE;
+
+YT_TESTP (cargs, abbreviated_names, TEST_ABBREV_CASE)
+{
+    TEST_ABBREV_CASE test_case = YT_ARG_0();
+
+    bool* verbose = cargs_add_arg ("verbose", "Verbose", Flag, "false");
+    bool* version = cargs_add_arg ("version", "Version", Flag, "false");
+    int* level    = cargs_add_arg ("level", "Level", Integer, "1");
+    bool* v       = cargs_add_arg ("v", "Verify", Flag, "false");
+
+    if (test_case == TEST_ABBREV_UNIQUE) {
+        char* argv[] = { "dummy", "-verb", "-lev", "3", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*verbose, true);
+        YT_EQ_SCALAR (*version, false);
+        YT_EQ_SCALAR (*level, 3);
+    } else if (test_case == TEST_ABBREV_FULL_NAME) {
+        char* argv[] = { "dummy", "-v", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*v, true);
+        YT_EQ_SCALAR (*verbose, false);
+    } else {
+        char* argv[] = { "dummy", "-ver", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, name_completion)
+{
+    cargs_add_arg ("version", "Version", Flag, "false");
+    cargs_add_arg ("verbose", "Verbose", Flag, "false");
+    cargs_add_arg ("level", "Level", Integer, "1");
+    cargs_add_arg ("v", "Verify", Flag, "false");
+
+    const char* names[2] = { NULL, NULL };
+    YT_EQ_SCALAR (cargs_complete ("-ver", names, ARRAY_LEN (names)), 2U);
+    YT_EQ_STRING (names[0], "-verbose");
+    YT_EQ_STRING (names[1], "-version");
+
+    YT_EQ_SCALAR (cargs_complete ("-v", names, ARRAY_LEN (names)), 3U);
+    YT_EQ_STRING (names[0], "-v");
+    YT_EQ_STRING (names[1], "-verbose");
+
+    YT_EQ_SCALAR (cargs_complete ("-l", names, ARRAY_LEN (names)), 1U);
+    YT_EQ_STRING (names[0], "-level");
+
+    YT_EQ_SCALAR (cargs_complete ("-x", names, ARRAY_LEN (names)), 0U);
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+YT_TEST (cargs, name_suggestion)
+{
+    cargs_add_arg ("verbose", "Verbose", Flag, "false");
+    cargs_add_arg ("version", "Version", Flag, "false");
+    cargs_add_arg ("level", "Level", Integer, "1");
+
+    Cargs_Parser* parser = &CARGS__default_parser;
+    YT_EQ_STRING (CARGS__suggest (parser, "-verbse", 7)->name, "-verbose");
+    YT_EQ_STRING (CARGS__suggest (parser, "-versoin", 8)->name, "-version");
+    YT_EQ_STRING (CARGS__suggest (parser, "-levle", 6)->name, "-level");
+    YT_EQ_STRING (CARGS__suggest (parser, "-lavel", 6)->name, "-level");
+    YT_EQ_SCALAR (CARGS__suggest (parser, "-x", 2), NULL);
+    YT_EQ_SCALAR (CARGS__suggest (parser, "-quiet", 6), NULL);
+
+    char* argv[] = { "dummy", "-levle", "3", NULL };
+    YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
+// Number, or -inf and inf for the smallest and largest ints.
+static bool test_bound_parse_string (struct Cargs_TypeInterface* self, const char* input,
+                                     Cargs_Slice out)
+{
+    if (strcmp (input, "-inf") == 0 || strcmp (input, "inf") == 0) {
+        *(int*)out.address = (input[0] == '-') ? INT_MIN : INT_MAX;
+        return true;
+    }
+    return cargs_int_parse_string (self, input, out);
+}
+
+static bool test_bound_check_string (struct Cargs_TypeInterface* self, const char* input)
+{
+    return strcmp (input, "-inf") == 0 || strcmp (input, "inf") == 0 ||
+           cargs_int_check_string (self, input);
+}
+
+Cargs_TypeInterface TestBound = {
+    CARGS_TYPEINTERFACE_PRIVATE_FIELDS_INIT,
+    .format_help  = "(number|-inf|inf)",
+    .type_size    = sizeof (int),
+    .parse_string = test_bound_parse_string,
+    .check_string = test_bound_check_string,
+};
+
+typedef enum {
+    TEST_TOKEN_NAME_VALUE,
+    TEST_TOKEN_BUNDLE,
+    TEST_TOKEN_NEGATIVE_VALUES,
+    TEST_TOKEN_FLAG_VALUE,
+    TEST_TOKEN_NEGATIVE_AFTER_FLAG,
+    TEST_TOKEN_VALUE_WITHOUT_ARG,
+    TEST_TOKEN_CUSTOM_PREFIXED_VALUES,
+} TEST_TOKEN_CASE;
+
+YT_TESTP (cargs, token_forms, TEST_TOKEN_CASE)
+{
+    TEST_TOKEN_CASE test_case = YT_ARG_0();
+
+    bool* a               = cargs_add_arg ("a", "All", Flag, "false");
+    bool* b               = cargs_add_arg ("b", "Brief", Flag, "false");
+    bool* c               = cargs_add_arg ("c", "Color", Flag, "false");
+    int* n                = cargs_add_arg ("n", "Count", Integer, "0");
+    double* d             = cargs_add_arg ("d", "Delta", Double, "0");
+    Cargs_ArrayList* v    = cargs_add_arg ("v", "Values", CARGS_LISTOF (Integer), "0");
+    Cargs_StringType* lvl = cargs_add_arg ("level", "Level", String, "low");
+    Cargs_ArrayList* bnd  = cargs_add_arg ("bound", "Bound", CARGS_LISTOF (TestBound), "0");
+
+    if (test_case == TEST_TOKEN_NAME_VALUE) {
+        char* argv[] = { "dummy", "--level=high", "-n=-7", "-v=1", "--v=2", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_STRING (*lvl, "high");
+        YT_EQ_SCALAR (*n, -7);
+        YT_EQ_SCALAR (v->len, 2U);
+        YT_EQ_SCALAR (((int*)v->buffer)[1], 2);
+    } else if (test_case == TEST_TOKEN_BUNDLE) {
+        char* argv[] = { "dummy", "-ab", "-cn", "5", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*a, true);
+        YT_EQ_SCALAR (*b, true);
+        YT_EQ_SCALAR (*c, true);
+        YT_EQ_SCALAR (*n, 5);
+    } else if (test_case == TEST_TOKEN_NEGATIVE_VALUES) {
+        char* argv[] = { "dummy", "-n", "-12", "-d", "-.5", "-v", "-1", "2", "-3", "-a", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (*n, -12);
+        YT_EQ_DOUBLE_ABS (*d, -0.5, 0.0);
+        YT_EQ_SCALAR (v->len, 3U);
+        YT_EQ_SCALAR (((int*)v->buffer)[0], -1);
+        YT_EQ_SCALAR (((int*)v->buffer)[2], -3);
+        YT_EQ_SCALAR (*a, true);
+    } else if (test_case == TEST_TOKEN_FLAG_VALUE) {
+        char* argv[] = { "dummy", "-a=true", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else if (test_case == TEST_TOKEN_NEGATIVE_AFTER_FLAG) {
+        char* argv[] = { "dummy", "-a", "-5", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else if (test_case == TEST_TOKEN_VALUE_WITHOUT_ARG) {
+        char* argv[] = { "dummy", "5", NULL };
+        YT_EQ_SCALAR (false, cargs_parse_input (ARRAY_LEN (argv), argv));
+    } else {
+        char* argv[] = { "dummy", "-bound", "-inf", "-3", "inf", "-a", NULL };
+        YT_EQ_SCALAR (true, cargs_parse_input (ARRAY_LEN (argv), argv));
+        YT_EQ_SCALAR (bnd->len, 3U);
+        YT_EQ_SCALAR (((int*)bnd->buffer)[0], INT_MIN);
+        YT_EQ_SCALAR (((int*)bnd->buffer)[1], -3);
+        YT_EQ_SCALAR (((int*)bnd->buffer)[2], INT_MAX);
+        YT_EQ_SCALAR (*a, true);
+    }
+
+    YT_MUST_NEVER_CALL (cargs_panic, _);
+    YT_END();
+}
+
 void yt_reset (void)
 {
     cargs_cleanup();
@@ -452,5 +1997,115 @@ int main (void)
     print_help (2, YT_ARG (bool){ true, false });
     dup_args_add_must_fail();
     dup_args_input_must_fail();
+    readd_args_after_cleanup();
+    static_schema();
+    static_schema_reuse();
+    static_schema_type_mismatch();
+    string_view_argument();
+    // response_file:
+    // Case 1: Tokens are separated by new lines.
+    // Case 2: Tokens are separated by null bytes.
+    response_file (2, YT_ARG (bool){ false, true });
+    response_file_missing();
+    // response_file_escape:
+    // Case 1: Response files are on, '@' is escaped.
+    // Case 2: Response files are off.
+    response_file_escape (2, YT_ARG (bool){ false, true });
+    // stream_type_argument:
+    // Case 1: Values are given, each is passed to the callback as it is parsed.
+    // Case 2: No values are given, default value is passed to the callback.
+    // Case 3: Callback rejects a value.
+    stream_type_argument (3, YT_ARG (TEST_STREAM_CASE){ TEST_STREAM_VALUES, TEST_STREAM_DEFAULT,
+                                                        TEST_STREAM_REJECTED });
+    independent_parsers();
+    batch_parsing();
+    batch_group_before_args();
+    batch_bump_allocator();
+    integer_types_parsing();
+    integer_trailing_garbage();
+    double_parsing();
+    // delimited_list_argument:
+    // Case 1: Values are given, with both delimiters and as separate tokens.
+    // Case 2: No values are given, default values are used.
+    // Case 3: Empty value between delimiters.
+    // Case 4: Long values, with 2 and with 5 delimiters.
+    delimited_list_argument (4, YT_ARG (TEST_DELIMITED_CASE){ TEST_DELIMITED_VALUES,
+                                                              TEST_DELIMITED_DEFAULT,
+                                                              TEST_DELIMITED_EMPTY_VALUE,
+                                                              TEST_DELIMITED_LONG_VALUES });
+    // when_argument:
+    // Case 1: All the arguments in the chain are enabled.
+    // Case 2: First argument in the chain is disabled.
+    // Case 3: Second argument in the chain is disabled.
+    when_argument (3, YT_ARG (TEST_WHEN_CASE){ TEST_WHEN_ALL_ENABLED, TEST_WHEN_FIRST_DISABLED,
+                                               TEST_WHEN_SECOND_DISABLED });
+    when_argument_cycle();
+    condition_evaluated_once();
+    // argument_groups:
+    // Case 1: All the groups are satisfied.
+    // Case 2: Two arguments of a mutex group are given.
+    // Case 3: Only one argument of a together group is given.
+    // Case 4: No argument of an at least one group is given.
+    argument_groups (4, YT_ARG (TEST_GROUP_CASE){ TEST_GROUP_SATISFIED, TEST_GROUP_MUTEX_VIOLATED,
+                                                  TEST_GROUP_TOGETHER_VIOLATED,
+                                                  TEST_GROUP_AT_LEAST_ONE_VIOLATED });
+    many_groups();
+    // lazy_argument:
+    // Case 1: Valid values, converted on access.
+    // Case 2: Value fails the check of the type, while parsing.
+    // Case 3: Value fails the conversion, on access.
+    lazy_argument (3, YT_ARG (TEST_LAZY_CASE){ TEST_LAZY_VALID, TEST_LAZY_CHECK_FAILS,
+                                               TEST_LAZY_CONVERSION_FAILS });
+    // lazy_builtin_argument:
+    // Case 1-3: Integer, valid, trailing garbage and out of range.
+    // Case 4-5: UInt64, valid and negative.
+    // Case 6-7: Hex, valid and not a hex digit.
+    // Case 8-9: Double, valid and two decimal points.
+    // Case 10-11: Boolean, valid and not true or false.
+    lazy_builtin_argument (11,
+                           YT_ARG (Cargs_TypeInterface*){ &Integer, &Integer, &Integer, &UInt64,
+                                                          &UInt64, &Hex, &Hex, &Double, &Double,
+                                                          &Boolean, &Boolean },
+                           YT_ARG (const char*){ "-12", "1x", "99999999999", "18446744073709551615",
+                                                 "-1", "0xff", "0xfg", "1.5e3", "1.5.2", "true",
+                                                 "yes" },
+                           YT_ARG (bool){ true, false, false, true, false, true, false, true, false,
+                                          true, false });
+    parse_statistics();
+    format_help();
+    // custom_allocator:
+    // Case 1: Allocator of the parser.
+    // Case 2: Default allocator.
+    // Case 3: Allocator of the parser, which allocates the arena.
+    custom_allocator (3, YT_ARG (TEST_ALLOCATOR_CASE){ TEST_ALLOCATOR_OF_PARSER,
+                                                       TEST_ALLOCATOR_DEFAULT,
+                                                       TEST_ALLOCATOR_WITH_ARENA });
+    bump_allocator();
+    // unaligned_buffer:
+    // Case 1: Arena in the buffer.
+    // Case 2: Bump allocator in the buffer.
+    unaligned_buffer (2, YT_ARG (TEST_UNALIGNED_CASE){ TEST_UNALIGNED_ARENA,
+                                                       TEST_UNALIGNED_BUMP_ALLOCATOR });
+    // abbreviated_names:
+    // Case 1: Names are given by their unique prefixes.
+    // Case 2: Full name is given, which is also a prefix of other names.
+    // Case 3: Prefix of two names is given.
+    abbreviated_names (3, YT_ARG (TEST_ABBREV_CASE){ TEST_ABBREV_UNIQUE, TEST_ABBREV_FULL_NAME,
+                                                     TEST_ABBREV_AMBIGUOUS });
+    name_completion();
+    name_suggestion();
+    // token_forms:
+    // Case 1: Values are given as name=value.
+    // Case 2: Flags are given together.
+    // Case 3: Negative values are given.
+    // Case 4: Value is given to a flag.
+    // Case 5: Negative number is given after a flag.
+    // Case 6: Value is given before any argument.
+    // Case 7: Prefixed values of a custom type are given to a list.
+    token_forms (7, YT_ARG (TEST_TOKEN_CASE){ TEST_TOKEN_NAME_VALUE, TEST_TOKEN_BUNDLE,
+                                              TEST_TOKEN_NEGATIVE_VALUES, TEST_TOKEN_FLAG_VALUE,
+                                              TEST_TOKEN_NEGATIVE_AFTER_FLAG,
+                                              TEST_TOKEN_VALUE_WITHOUT_ARG,
+                                              TEST_TOKEN_CUSTOM_PREFIXED_VALUES });
     YT_RETURN_WITH_REPORT();
 }